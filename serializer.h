@@ -3,10 +3,12 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <new>
 #include <stdexcept>
@@ -19,11 +21,17 @@
 #include <optional>
 #include <variant>
 #endif
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
 #ifdef ZPP_SERIALIZER_FREESTANDING
 #include <string_view>
 #else
+#include <atomic>
+#include <future>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #endif
 
@@ -418,6 +426,7 @@ enum class error : int
     out_of_range = 1,
     variant_is_valueless = 2,
     null_pointer_serialization = 3,
+    allocation_budget_exceeded = 4,
 };
 
 inline const freestanding::error_category & category(error)
@@ -438,6 +447,9 @@ inline const freestanding::error_category & category(error)
                 case error::null_pointer_serialization:
                     return "[zpp::serializer] Cannot serialize a null "
                            "pointer.";
+                case error::allocation_budget_exceeded:
+                    return "[zpp::serializer] Allocation budget "
+                           "exceeded.";
                 default:
                     return "[zpp::serializer] Unknown error occurred.";
                 }
@@ -484,6 +496,25 @@ struct all_of<true> : std::true_type
 {
 };
 
+/**
+ * Sums all the given values, empty means zero.
+ * Example:
+ * ~~~
+ * sum<1, 2, 3>::value == 6
+ * sum<>::value == 0
+ * ~~~
+ */
+template <std::size_t... Values>
+struct sum : std::integral_constant<std::size_t, 0>
+{
+};
+
+template <std::size_t Value, std::size_t... Values>
+struct sum<Value, Values...>
+    : std::integral_constant<std::size_t, Value + sum<Values...>::value>
+{
+};
+
 /**
  * Remove const of container value_type
  */
@@ -607,6 +638,422 @@ struct has_data_member_function<
 {
 };
 
+/**
+ * Reserves room for the given number of items, for containers with
+ * reserve method.
+ */
+template <typename Container, typename SizeType>
+auto reserve_if_reservable(Container & container, SizeType size, int)
+    -> decltype(container.reserve(size))
+{
+    return container.reserve(size);
+}
+
+/**
+ * Reserves room for the given number of items, does nothing for
+ * containers without reserve method.
+ */
+template <typename Container, typename SizeType>
+void reserve_if_reservable(Container &, SizeType, ...)
+{
+}
+
+/**
+ * Checks if the container is node based associative container, whose
+ * nodes can be extracted.
+ */
+template <typename Container, typename = void>
+struct is_node_container : std::false_type
+{
+};
+
+/**
+ * Checks if the container is node based associative container, whose
+ * nodes can be extracted.
+ */
+template <typename Container>
+struct is_node_container<Container, void_t<typename Container::node_type>>
+    : std::true_type
+{
+};
+
+/**
+ * Checks if the container is std::vector<bool>.
+ */
+template <typename Container>
+struct is_bool_vector : std::false_type
+{
+};
+
+/**
+ * Checks if the container is std::vector<bool>.
+ */
+template <typename Allocator>
+struct is_bool_vector<std::vector<bool, Allocator>> : std::true_type
+{
+};
+
+/**
+ * Checks if the container is a random access container of fundamental
+ * or enumeration types, without 'data()' member function, such as
+ * std::deque, whose items are stored in contiguous segments.
+ */
+template <typename Container, typename = void>
+struct is_segmented_container : std::false_type
+{
+};
+
+/**
+ * Checks if the container is a random access container of fundamental
+ * or enumeration types, without 'data()' member function.
+ */
+template <typename Container>
+struct is_segmented_container<
+    Container,
+    std::enable_if_t<
+        (std::is_fundamental<typename Container::value_type>::value ||
+         std::is_enum<typename Container::value_type>::value) &&
+        std::is_base_of<std::random_access_iterator_tag,
+                        typename std::iterator_traits<
+                            typename Container::iterator>::
+                            iterator_category>::value &&
+        !has_data_member_function<Container>::value &&
+        !is_bool_vector<Container>::value>> : std::true_type
+{
+};
+
+/**
+ * Returns the number of items, up to 'count', that are stored
+ * contiguously starting at the given random access iterator.
+ * Since the items of segmented containers are stored in blocks, the end
+ * of the block is found by galloping and then binary search, so that a
+ * block costs a logarithmic number of address comparisons. Addresses
+ * are compared as integers, to avoid pointer arithmetic past the block.
+ */
+template <typename Iterator>
+std::size_t contiguous_run(Iterator first, std::size_t count) noexcept
+{
+    // The address of the first item, and the item size.
+    auto address = reinterpret_cast<std::uintptr_t>(std::addressof(*first));
+    constexpr auto item_size = sizeof(*first);
+
+    // Returns whether the item at the index follows the first in memory.
+    auto in_place = [&](std::size_t index) {
+        return reinterpret_cast<std::uintptr_t>(
+                   std::addressof(first[index])) ==
+               address + index * item_size;
+    };
+
+    // Gallop until an item is out of place, doubling the step.
+    std::size_t run = 1;
+    std::size_t end = count;
+    for (std::size_t step = 1; run < count; step *= 2) {
+        auto next = std::min(count, run + step);
+        if (!in_place(next - 1)) {
+            end = next - 1;
+            break;
+        }
+        run = next;
+    }
+
+    // Binary search for the first out of place item, if any.
+    while (run < end) {
+        auto middle = run + (end - run) / 2;
+        if (in_place(middle)) {
+            run = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return run;
+}
+
+/**
+ * Checks if the container is a string that is serialized using the
+ * string dictionary of the archive, if any.
+ */
+template <typename Container>
+struct is_dictionary_string : std::false_type
+{
+};
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * Checks if the container is a string that is serialized using the
+ * string dictionary of the archive, if any.
+ */
+template <>
+struct is_dictionary_string<std::string> : std::true_type
+{
+};
+#endif
+
+/**
+ * Checks if has 'size()', 'begin()' and 'end()' member functions.
+ */
+template <typename Type, typename = void>
+struct is_sized_range : std::false_type
+{
+};
+
+/**
+ * Checks if has 'size()', 'begin()' and 'end()' member functions.
+ */
+template <typename Type>
+struct is_sized_range<Type,
+                      void_t<decltype(std::declval<Type &>().size()),
+                             decltype(std::declval<Type &>().begin()),
+                             decltype(std::declval<Type &>().end())>>
+    : std::true_type
+{
+};
+
+/**
+ * Checks if has 'before_begin()' member function.
+ */
+template <typename Type, typename = void>
+struct has_before_begin : std::false_type
+{
+};
+
+/**
+ * Checks if has 'before_begin()' member function.
+ */
+template <typename Type>
+struct has_before_begin<
+    Type,
+    void_t<decltype(std::declval<Type &>().before_begin())>>
+    : std::true_type
+{
+};
+
+/**
+ * Checks if has 'resize()' member function.
+ */
+template <typename Type, typename = void>
+struct has_resize : std::false_type
+{
+};
+
+/**
+ * Checks if has 'resize()' member function.
+ */
+template <typename Type>
+struct has_resize<
+    Type,
+    void_t<decltype(std::declval<Type &>().resize(std::size_t()))>>
+    : std::true_type
+{
+};
+
+/**
+ * Checks if has 'key_type' member type.
+ */
+template <typename Type, typename = void>
+struct has_key_type : std::false_type
+{
+};
+
+/**
+ * Checks if has 'key_type' member type.
+ */
+template <typename Type>
+struct has_key_type<Type, void_t<typename Type::key_type>> : std::true_type
+{
+};
+
+/**
+ * Checks if the container is a random access container of fundamental
+ * or enumeration types, with 'data()' member function, such as
+ * std::vector, whose items are stored contiguously.
+ */
+template <typename Container, typename = void>
+struct is_contiguous_container : std::false_type
+{
+};
+
+/**
+ * Checks if the container is a random access container of fundamental
+ * or enumeration types, with 'data()' member function.
+ */
+template <typename Container>
+struct is_contiguous_container<
+    Container,
+    std::enable_if_t<
+        (std::is_fundamental<typename Container::value_type>::value ||
+         std::is_enum<typename Container::value_type>::value) &&
+        std::is_base_of<std::random_access_iterator_tag,
+                        typename std::iterator_traits<
+                            typename Container::iterator>::
+                            iterator_category>::value &&
+        has_data_member_function<Container>::value>> : std::true_type
+{
+};
+
+/**
+ * Container categories, each category is serialized by its own overload
+ * of load_container and save_container.
+ * Saving overloads accept the base category of the loading ones.
+ */
+struct sequence_container_tag
+{
+};
+
+struct resizable_container_tag : sequence_container_tag
+{
+};
+
+struct view_container_tag : sequence_container_tag
+{
+};
+
+struct associative_container_tag : sequence_container_tag
+{
+};
+
+struct contiguous_container_tag
+{
+};
+
+struct resizable_contiguous_container_tag : contiguous_container_tag
+{
+};
+
+struct contiguous_view_container_tag : contiguous_container_tag
+{
+};
+
+struct segmented_container_tag
+{
+};
+
+struct singly_linked_container_tag
+{
+};
+
+struct dictionary_string_tag
+{
+};
+
+struct bool_vector_tag
+{
+};
+
+/**
+ * Classifies the container into its category, void for types that are
+ * not containers. Every container type is classified once, rather than
+ * probed by every container overload.
+ */
+template <typename Container, typename = void>
+struct container_category
+{
+    using type = void;
+};
+
+/**
+ * Classifies the container into its category.
+ */
+template <typename Container>
+struct container_category<
+    Container,
+    std::enable_if_t<is_sized_range<Container>::value ||
+                     has_before_begin<Container>::value>>
+{
+    /**
+     * The category of a contiguous or non contiguous sequence container.
+     */
+    template <typename Resizable, typename View, typename Other>
+    using sequence_category = std::conditional_t<
+        has_resize<Container>::value,
+        Resizable,
+        std::conditional_t<std::is_trivially_destructible<Container>::value,
+                           View,
+                           Other>>;
+
+    using type = std::conditional_t<
+        is_bool_vector<Container>::value,
+        bool_vector_tag,
+        std::conditional_t<
+            is_dictionary_string<Container>::value,
+            dictionary_string_tag,
+            std::conditional_t<
+                has_before_begin<Container>::value,
+                singly_linked_container_tag,
+                std::conditional_t<
+                    has_key_type<Container>::value,
+                    associative_container_tag,
+                    std::conditional_t<
+                        is_segmented_container<Container>::value,
+                        segmented_container_tag,
+                        std::conditional_t<
+                            is_contiguous_container<Container>::value,
+                            sequence_category<
+                                resizable_contiguous_container_tag,
+                                contiguous_view_container_tag,
+                                contiguous_container_tag>,
+                            sequence_category<resizable_container_tag,
+                                              view_container_tag,
+                                              sequence_container_tag>>>>>>>;
+};
+
+/**
+ * The category of the container, void for types that are not
+ * containers.
+ */
+template <typename Container>
+using container_category_t = typename container_category<Container>::type;
+
+/**
+ * The size of the buffer used when packing bits into bytes.
+ */
+constexpr std::size_t bit_buffer_size = 256;
+
+/**
+ * Packs 'count' bits starting at 'offset' of the given bit container
+ * into bytes, eight bits per byte, least significant bit first.
+ */
+template <typename Bits>
+void pack_bits(const Bits & bits,
+               std::size_t offset,
+               std::size_t count,
+               unsigned char * bytes) noexcept
+{
+    for (std::size_t i{}; i < count; i += 8) {
+        auto bits_in_byte = std::min<std::size_t>(count - i, 8);
+        unsigned char byte{};
+        for (std::size_t j{}; j < bits_in_byte; ++j) {
+            byte |= static_cast<unsigned char>(
+                (bits[offset + i + j] ? 1u : 0u) << j);
+        }
+        bytes[i / 8] = byte;
+    }
+}
+
+/**
+ * Unpacks 'count' bits from the given bytes into the given bit container
+ * starting at 'offset', eight bits per byte, least significant bit first.
+ */
+template <typename Bits>
+void unpack_bits(const unsigned char * bytes,
+                 std::size_t count,
+                 Bits & bits,
+                 std::size_t offset) noexcept
+{
+    for (std::size_t i{}; i < count; ++i) {
+        bits[offset + i] = ((bytes[i / 8] >> (i % 8)) & 1u) != 0;
+    }
+}
+
+/**
+ * The integral type that represents a bit field item, the underlying
+ * type for enumerations, else the type itself.
+ */
+template <typename Item>
+using bit_field_integral_t = typename std::conditional_t<
+    std::is_enum<std::remove_const_t<Item>>::value,
+    std::underlying_type<std::remove_const_t<Item>>,
+    std::remove_const<Item>>::type;
+
 } // namespace detail
 
 /**
@@ -623,6 +1070,12 @@ using polymorphic_type_mismatch_error =
 using attempt_to_serialize_valueless_variant =
     detail::exception<std::runtime_error, 4>;
 using variant_index_out_of_range = detail::exception<std::out_of_range, 5>;
+using tracked_type_mismatch_error =
+    detail::exception<std::runtime_error, 6>;
+using patch_structure_mismatch_error =
+    detail::exception<std::runtime_error, 7>;
+using allocation_budget_exceeded_error =
+    detail::exception<std::runtime_error, 8>;
 /**
  * @}
  */
@@ -717,39 +1170,276 @@ using size_type = std::uint32_t;
  */
 using id_type = std::uint64_t;
 
+namespace detail
+{
 /**
- * This class grants the serializer access to the serialized types.
+ * The minimum number of bytes an item is serialized in, or zero if
+ * unknown, used to bound loaded container sizes by the input size.
  */
-class access
+template <typename Item, typename = void>
+struct min_serialized_size : std::integral_constant<std::size_t, 0>
 {
-public:
-    /**
-     * Allows placement construction of types.
-     */
-    template <typename Item, typename... Arguments>
-    static auto
-    placement_new(void * pAddress, Arguments &&... arguments) noexcept(
-        noexcept(Item(std::forward<Arguments>(arguments)...)))
-    {
-        return ::new (pAddress)
-            Item(std::forward<Arguments>(arguments)...);
-    }
+};
 
-    /**
-     * Allows dynamic construction of types.
-     * This overload is for non polymorphic serialization.
-     */
-    template <typename Item,
-              typename... Arguments,
-              typename = std::enable_if_t<
-                  !std::is_base_of<polymorphic, Item>::value>>
-    static auto make_unique(Arguments &&... arguments)
-    {
-        // Construct the requested type, using new since constructor might
-        // be private.
-        return std::unique_ptr<Item>(
-            new Item(std::forward<Arguments>(arguments)...));
-    }
+/**
+ * The minimum number of bytes an item is serialized in.
+ * This overload is for fundamental types and enumerations.
+ */
+template <typename Item>
+struct min_serialized_size<
+    Item,
+    std::enable_if_t<std::is_fundamental<Item>::value ||
+                     std::is_enum<Item>::value>>
+    : std::integral_constant<std::size_t, sizeof(Item)>
+{
+};
+
+/**
+ * The minimum number of bytes an item is serialized in.
+ * This overload is for containers, which are serialized with their size.
+ */
+template <typename Item>
+struct min_serialized_size<
+    Item,
+    void_t<decltype(std::declval<Item &>().size()),
+           decltype(std::declval<Item &>().begin()),
+           decltype(std::declval<Item &>().clear())>>
+    : std::integral_constant<std::size_t, sizeof(size_type)>
+{
+};
+
+/**
+ * The minimum number of bytes an item is serialized in.
+ * This overload is for std::array.
+ */
+template <typename Item, std::size_t Size>
+struct min_serialized_size<std::array<Item, Size>>
+    : std::integral_constant<
+          std::size_t,
+          min_serialized_size<std::remove_const_t<Item>>::value * Size>
+{
+};
+
+/**
+ * The minimum number of bytes an item is serialized in.
+ * This overload is for std::pair.
+ */
+template <typename First, typename Second>
+struct min_serialized_size<std::pair<First, Second>>
+    : sum<min_serialized_size<std::remove_const_t<First>>::value,
+          min_serialized_size<std::remove_const_t<Second>>::value>
+{
+};
+
+/**
+ * The minimum number of bytes an item is serialized in.
+ * This overload is for std::tuple.
+ */
+template <typename... Items>
+struct min_serialized_size<std::tuple<Items...>>
+    : sum<min_serialized_size<std::remove_const_t<Items>>::value...>
+{
+};
+
+/**
+ * Returns the number of input bytes remaining in the archive, for
+ * archives that tell.
+ */
+template <typename Archive>
+auto remaining_of(Archive & archive, int) noexcept
+    -> decltype(archive.remaining())
+{
+    return archive.remaining();
+}
+
+/**
+ * Returns the number of input bytes remaining in the archive, which is
+ * unbounded for archives that do not tell.
+ */
+template <typename Archive>
+std::size_t remaining_of(Archive &, ...) noexcept
+{
+    return (std::numeric_limits<std::size_t>::max)();
+}
+
+/**
+ * Returns the remaining allocation budget of the archive, for archives
+ * with allocation budget.
+ */
+template <typename Archive>
+auto allocation_budget_of(Archive & archive, int) noexcept
+    -> decltype(archive.allocation_budget())
+{
+    return archive.allocation_budget();
+}
+
+/**
+ * Returns the remaining allocation budget of the archive, which is
+ * unlimited for archives without allocation budget.
+ */
+template <typename Archive>
+std::size_t allocation_budget_of(Archive &, ...) noexcept
+{
+    return (std::numeric_limits<std::size_t>::max)();
+}
+
+/**
+ * Consumes the given size from the allocation budget of the archive,
+ * for archives with allocation budget. Returns false if exceeded, else
+ * true.
+ */
+template <typename Archive>
+auto consume_allocation_budget_of(Archive & archive,
+                                  std::size_t size,
+                                  int) noexcept
+    -> decltype(archive.consume_allocation_budget(size))
+{
+    return archive.consume_allocation_budget(size);
+}
+
+/**
+ * Consumes the given size from the allocation budget of the archive,
+ * which is unlimited for archives without allocation budget.
+ */
+template <typename Archive>
+bool consume_allocation_budget_of(Archive &, std::size_t, ...) noexcept
+{
+    return true;
+}
+
+/**
+ * Marks the archive as failed, for archives with sticky errors, and
+ * returns true.
+ */
+template <typename Archive>
+auto fail_of(Archive & archive, int) -> decltype(archive.fail(), bool())
+{
+    archive.fail();
+    return true;
+}
+
+/**
+ * Returns false, for archives without sticky errors, which report
+ * errors as they happen instead.
+ */
+template <typename Archive>
+bool fail_of(Archive &, ...) noexcept
+{
+    return false;
+}
+
+/**
+ * Returns whether the archive failed, for archives with sticky errors.
+ */
+template <typename Archive>
+auto failed_of(Archive & archive, int) noexcept
+    -> decltype(archive.failed())
+{
+    return archive.failed();
+}
+
+/**
+ * Returns false, for archives without sticky errors.
+ */
+template <typename Archive>
+bool failed_of(Archive &, ...) noexcept
+{
+    return false;
+}
+
+/**
+ * Verifies that 'count' items, each serialized in at least 'min_size'
+ * bytes and stored in 'item_size' bytes, may be loaded from the archive.
+ * The items must fit in the remaining input, and their storage in the
+ * allocation budget of the archive, which is consumed.
+ * Archives with sticky errors fail instead, and the count is cleared.
+ */
+template <typename Archive, typename Count>
+auto verify_load_size(Archive & archive,
+                      Count & count,
+                      std::size_t min_size,
+                      std::size_t item_size)
+{
+    // Verify that the items fit in the remaining input.
+    if (min_size && count > remaining_of(archive, 0) / min_size) {
+        // Archives with sticky errors fail, and load no items.
+        if (fail_of(archive, 0)) {
+            count = 0;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            return;
+#else
+            return freestanding::error{error::success};
+#endif
+        }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw out_of_range("Input was not large enough to contain the "
+                           "requested items");
+#else
+        return freestanding::error{error::out_of_range};
+#endif
+    }
+
+    // Consume the storage size from the allocation budget.
+    if (item_size &&
+        (count > (std::numeric_limits<std::size_t>::max)() / item_size ||
+         !consume_allocation_budget_of(archive, count * item_size, 0))) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw allocation_budget_exceeded_error(
+            "Loading the requested items exceeds the allocation budget.");
+#else
+        return freestanding::error{error::allocation_budget_exceeded};
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * The number of items a container whose items may be serialized in no
+ * bytes is initially resized to, when loading, from which it grows as
+ * items are loaded.
+ */
+template <typename Item>
+constexpr std::size_t initial_load_size =
+    std::max<std::size_t>((std::size_t(1) << 16) / sizeof(Item), 1);
+} // namespace detail
+
+/**
+ * This class grants the serializer access to the serialized types.
+ */
+class access
+{
+public:
+    /**
+     * Allows placement construction of types.
+     */
+    template <typename Item, typename... Arguments>
+    static auto
+    placement_new(void * pAddress, Arguments &&... arguments) noexcept(
+        noexcept(Item(std::forward<Arguments>(arguments)...)))
+    {
+        return ::new (pAddress)
+            Item(std::forward<Arguments>(arguments)...);
+    }
+
+    /**
+     * Allows dynamic construction of types.
+     * This overload is for non polymorphic serialization.
+     */
+    template <typename Item,
+              typename... Arguments,
+              typename = std::enable_if_t<
+                  !std::is_base_of<polymorphic, Item>::value>>
+    static auto make_unique(Arguments &&... arguments)
+    {
+        // Construct the requested type, using new since constructor might
+        // be private.
+        return std::unique_ptr<Item>(
+            new Item(std::forward<Arguments>(arguments)...));
+    }
 
     /**
      * Allows dynamic construction of types.
@@ -918,13 +1608,34 @@ template <typename Archive>
 using serialization_method_t =
     typename serialization_method<Archive>::type;
 
+/**
+ * An input archive that skips serialized data without constructing it.
+ */
+class skipping_archive;
+
+namespace detail
+{
+/**
+ * Returns a default constructed object of the given type, one per
+ * thread, that the skipping archive walks in place of the skipped items.
+ */
+template <typename Type>
+Type & skipped_object()
+{
+    thread_local auto object = access::make_unique<Type>();
+    return *object;
+}
+} // namespace detail
+
 /**
  * Make a serialization method from type and a loading (input) archive.
  */
 template <typename Archive,
           typename Type,
           typename...,
-          typename = typename Archive::loading>
+          typename = std::enable_if_t<
+              !std::is_same<Archive, skipping_archive>::value,
+              typename Archive::loading>>
 serialization_method_t<Archive> make_serialization_method() noexcept
 {
     return [](Archive & archive, std::unique_ptr<polymorphic> & object) {
@@ -949,6 +1660,101 @@ serialization_method_t<Archive> make_serialization_method() noexcept
     };
 }
 
+/**
+ * Make a skip method from type and a skipping archive, that skips the
+ * object without constructing it.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename = std::enable_if_t<
+              std::is_same<Archive, skipping_archive>::value>,
+          typename = void,
+          typename = void>
+serialization_method_t<Archive> make_serialization_method() noexcept
+{
+    return [](Archive & archive, std::unique_ptr<polymorphic> &) {
+        archive(detail::skipped_object<Type>());
+    };
+}
+
+namespace detail
+{
+/**
+ * Checks if serialization of the item with the archive is explicitly
+ * instantiated in another translation unit, as declared by
+ * ZPP_SERIALIZER_EXTERN_SERIALIZATION.
+ */
+template <typename Archive, typename Item>
+struct is_extern_serialization : std::false_type
+{
+};
+
+/**
+ * The type of the serialized item, const for saving (output) archives.
+ */
+template <typename Archive, typename Item, typename = void>
+struct serialized_type
+{
+    using type = Item;
+};
+
+/**
+ * The type of the serialized item, const for saving (output) archives.
+ */
+template <typename Archive, typename Item>
+struct serialized_type<Archive, Item, typename Archive::saving>
+{
+    using type = const Item;
+};
+
+/**
+ * The type of the serialized item, const for saving (output) archives.
+ */
+template <typename Archive, typename Item>
+using serialized_type_t = typename serialized_type<Archive, Item>::type;
+
+/**
+ * The result of the serialize method of explicitly instantiated
+ * serialization.
+ */
+#ifndef ZPP_SERIALIZER_FREESTANDING
+using serialization_result_t = void;
+#else
+using serialization_result_t = freestanding::error;
+#endif
+
+/**
+ * Calls the serialize method of the item, with a declared result type,
+ * so that it can be explicitly instantiated.
+ */
+template <typename Archive, typename Item>
+serialization_result_t serialize_instance(Archive & archive, Item & item)
+{
+    return Item::serialize(archive, item);
+}
+
+/**
+ * Calls the serialize method of the item.
+ */
+template <typename Archive, typename Item>
+auto serialize_method(Archive & archive, Item & item, std::false_type)
+{
+    return Item::serialize(archive, item);
+}
+
+/**
+ * Calls the explicitly instantiated serialize method of the item.
+ */
+template <typename Archive, typename Item>
+serialization_result_t
+serialize_method(Archive & archive, Item & item, std::true_type)
+{
+    return serialize_instance<Archive, serialized_type_t<Archive, Item>>(
+        archive, item);
+}
+} // namespace detail
+
 /**
  * This is the base archive of the serializer.
  * It enables saving and loading items into/from the archive, via
@@ -1031,9 +1837,16 @@ private:
                   std::declval<archive_type &>(), std::declval<Item &>()))>
     auto serialize_item(Item && item)
     {
-        // Forward as lvalue.
-        return std::remove_reference_t<Item>::serialize(concrete_archive(),
-                                                        item);
+        // The serialized item type.
+        using item_type = std::remove_reference_t<Item>;
+
+        // Forward as lvalue, to the explicit instantiation if declared.
+        return detail::serialize_method(
+            concrete_archive(),
+            item,
+            detail::is_extern_serialization<
+                archive_type,
+                detail::serialized_type_t<archive_type, item_type>>{});
     }
 
     /**
@@ -1112,6 +1925,19 @@ private:
     }
 }; // archive
 
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * A dictionary of strings, that allows serializing repeated strings once.
+ */
+class string_dictionary;
+
+/**
+ * Tracks the identity of shared objects, that allows serializing shared
+ * objects once.
+ */
+class object_tracker;
+#endif
+
 /**
  * This archive serves as an output archive, which saves data into memory.
  * Every save operation appends data into the vector or view type.
@@ -1269,6 +2095,43 @@ protected:
         m_offset = offset;
     }
 
+public:
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Returns the string dictionary in use, or null if none.
+     */
+    string_dictionary * dictionary() const noexcept
+    {
+        return m_dictionary;
+    }
+
+    /**
+     * Use the given string dictionary for saving strings, or null to
+     * save strings in full.
+     */
+    void use_dictionary(string_dictionary * dictionary) noexcept
+    {
+        m_dictionary = dictionary;
+    }
+
+    /**
+     * Returns the object tracker in use, or null if none.
+     */
+    object_tracker * tracker() const noexcept
+    {
+        return m_tracker;
+    }
+
+    /**
+     * Use the given object tracker for saving shared objects, or null
+     * to save shared objects every time they are reached.
+     */
+    void use_tracker(object_tracker * tracker) noexcept
+    {
+        m_tracker = tracker;
+    }
+#endif
+
 private:
     /**
      * The output vector, may be null in which case working with
@@ -1290,6 +2153,18 @@ private:
      * The offset of the output data.
      */
     std::size_t m_offset{};
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * The string dictionary, may be null.
+     */
+    string_dictionary * m_dictionary{};
+
+    /**
+     * The object tracker, may be null.
+     */
+    object_tracker * m_tracker{};
+#endif
 }; // basic_memory_output_archive
 
 /**
@@ -1379,10 +2254,32 @@ public:
      * Allow to reset offset for advanced use.
      */
     using base::reset;
-};
 
-/**
- * This archive serves as an output archive, which saves data into memory.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Returns the string dictionary in use.
+     */
+    using base::dictionary;
+
+    /**
+     * Allow to use a string dictionary.
+     */
+    using base::use_dictionary;
+
+    /**
+     * Returns the object tracker in use.
+     */
+    using base::tracker;
+
+    /**
+     * Allow to use an object tracker.
+     */
+    using base::use_tracker;
+#endif
+};
+
+/**
+ * This archive serves as an output archive, which saves data into memory.
  * Every save operation appends data into the vector.
  */
 class memory_output_archive : private basic_memory_output_archive
@@ -1450,6 +2347,28 @@ public:
      * Allow to reset offset for advanced use.
      */
     using base::reset;
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Returns the string dictionary in use.
+     */
+    using base::dictionary;
+
+    /**
+     * Allow to use a string dictionary.
+     */
+    using base::use_dictionary;
+
+    /**
+     * Returns the object tracker in use.
+     */
+    using base::tracker;
+
+    /**
+     * Allow to use an object tracker.
+     */
+    using base::use_tracker;
+#endif
 };
 
 /**
@@ -1536,7 +2455,94 @@ public:
         m_offset = offset;
     }
 
+    /**
+     * Returns the number of input bytes remaining to be loaded.
+     */
+    std::size_t remaining() const noexcept
+    {
+        return m_size - m_offset;
+    }
+
+    /**
+     * Returns the remaining allocation budget, in bytes.
+     */
+    std::size_t allocation_budget() const noexcept
+    {
+        return m_allocation_budget;
+    }
+
+    /**
+     * Sets the allocation budget, that is the number of bytes that
+     * loading containers may allocate for their items, until set again.
+     * Loading a container whose items exceed the budget fails.
+     * The budget is unlimited by default.
+     */
+    void set_allocation_budget(std::size_t budget) noexcept
+    {
+        m_allocation_budget = budget;
+    }
+
+    /**
+     * Consumes the given size from the allocation budget.
+     * Returns false if exceeding the budget, in which case nothing is
+     * consumed, else true.
+     */
+    bool consume_allocation_budget(std::size_t size) noexcept
+    {
+        if (size > m_allocation_budget) {
+            return false;
+        }
+        m_allocation_budget -= size;
+        return true;
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Returns the string dictionary in use, or null if none.
+     */
+    string_dictionary * dictionary() const noexcept
+    {
+        return m_dictionary;
+    }
+
+    /**
+     * Use the given string dictionary for loading strings, or null to
+     * load strings in full.
+     */
+    void use_dictionary(string_dictionary * dictionary) noexcept
+    {
+        m_dictionary = dictionary;
+    }
+
+    /**
+     * Returns the object tracker in use, or null if none.
+     */
+    object_tracker * tracker() const noexcept
+    {
+        return m_tracker;
+    }
+
+    /**
+     * Use the given object tracker for loading shared objects, or null
+     * to load shared objects every time they are reached.
+     */
+    void use_tracker(object_tracker * tracker) noexcept
+    {
+        m_tracker = tracker;
+    }
+#endif
+
 protected:
+    /**
+     * Refreshes the input data, and resets the offset.
+     */
+    void refresh(const unsigned char * input, std::size_t size) noexcept
+    {
+        m_input = input;
+        m_size = size;
+        m_offset = {};
+    }
+
     /**
      * Serialize a single item - load it from the vector.
      */
@@ -1609,6 +2615,24 @@ private:
      * The next input.
      */
     std::size_t m_offset{};
+
+    /**
+     * The remaining allocation budget.
+     */
+    std::size_t m_allocation_budget =
+        (std::numeric_limits<std::size_t>::max)();
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * The string dictionary, may be null.
+     */
+    string_dictionary * m_dictionary{};
+
+    /**
+     * The object tracker, may be null.
+     */
+    object_tracker * m_tracker{};
+#endif
 }; // memory_view_input_archive
 
 /**
@@ -1640,8 +2664,7 @@ public:
     auto operator()(Items &&... items)
     {
         // Update the input archive.
-        static_cast<memory_view_input_archive &>(*this) = {
-            m_input->data(), m_input->size()};
+        refresh(m_input->data(), m_input->size());
 
         // Save the original offset.
         auto offset = this->offset();
@@ -1695,6 +2718,43 @@ public:
      */
     using base::reset;
 
+    /**
+     * Returns the number of input bytes remaining.
+     */
+    using base::remaining;
+
+    /**
+     * Returns the remaining allocation budget.
+     */
+    using base::allocation_budget;
+
+    /**
+     * Allow to set the allocation budget.
+     */
+    using base::set_allocation_budget;
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Returns the string dictionary in use.
+     */
+    using base::dictionary;
+
+    /**
+     * Allow to use a string dictionary.
+     */
+    using base::use_dictionary;
+
+    /**
+     * Returns the object tracker in use.
+     */
+    using base::tracker;
+
+    /**
+     * Allow to use an object tracker.
+     */
+    using base::use_tracker;
+#endif
+
 private:
     /**
      * The input data.
@@ -1702,1294 +2762,8036 @@ private:
     std::vector<unsigned char> * m_input{};
 };
 
-#ifndef ZPP_SERIALIZER_FREESTANDING
 /**
- * This class manages polymorphic type registration for serialization
- * process.
+ * This archive serializes a batch of messages back to back into a single
+ * vector, and records the offset at which every message starts.
+ * Unlike memory_output_archive, the vector is refreshed and fitted once
+ * per batch rather than once per message.
+ * A message that fails to serialize is discarded.
  */
-template <typename Archive>
-class registry
+class batch_writer : private basic_memory_output_archive
 {
 public:
-    static_assert(!std::is_reference<Archive>::value,
-                  "Disallows reference type for archive in registry");
+    /**
+     * The base archive.
+     */
+    using base = basic_memory_output_archive;
 
     /**
-     * Returns the global instance of the registry.
+     * Constructs a batch writer, that appends messages to the given
+     * vector.
      */
-    static registry & get_instance() noexcept
+    explicit batch_writer(std::vector<unsigned char> & output) :
+        basic_memory_output_archive(output)
     {
-        static registry registry;
-        return registry;
+        refresh_vector();
     }
 
     /**
-     * Add a serialization method for a given polymorphic type and id.
+     * Fits the vector to the serialized messages.
      */
-    template <typename Type, id_type id>
-    void add()
+    ~batch_writer()
     {
-        add<Type>(id);
+        finish();
     }
 
     /**
-     * Adds a serialization method for a given polymorphic type and id.
+     * Disabled copy constructor.
      */
-    template <typename Type>
-    void add(id_type id)
+    batch_writer(const batch_writer &) = delete;
+
+    /**
+     * Disabled copy assignment.
+     */
+    batch_writer & operator=(const batch_writer &) = delete;
+
+    /**
+     * Saves a message made of the given items, after the previous
+     * message.
+     */
+    template <typename... Items>
+    auto add(Items &&... items)
     {
-        add(id,
-            typeid(Type).name(),
-            make_serialization_method<Archive, Type>());
+        discard_incomplete();
+
+        // Record the offset of the message.
+        m_offsets.push_back(this->offset());
+        m_incomplete = true;
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        // Serialize the items.
+        base::operator()(std::forward<Items>(items)...);
+        m_incomplete = false;
+#else
+        // Serialize the items.
+        auto result = base::operator()(std::forward<Items>(items)...);
+        if (!result) {
+            discard_incomplete();
+            return result;
+        }
+
+        m_incomplete = false;
+        return result;
+#endif
     }
 
     /**
-     * Add a serialization method for a given polymorphic type information
-     * string and id. The behavior is undefined if the type isn't derived
-     * from polymorphic.
+     * Fits the vector to the serialized messages. More messages may be
+     * added afterwards.
      */
-    void add(id_type id,
-             std::string type_information_string,
-             serialization_method_t<Archive> serialization_method)
+    void finish()
     {
-        // Lock the serialization method maps for write access.
-        std::lock_guard<shared_mutex> lock(m_shared_mutex);
-
-        // Add the serialization id to serialization method mapping.
-        m_serialization_id_to_method.emplace(
-            id, std::move(serialization_method));
+        discard_incomplete();
+        fit_vector();
+        refresh_vector();
+    }
 
-        // Add the type information to to serialization id mapping.
-        m_type_information_to_serialization_id.emplace(
-            std::move(type_information_string), id);
+    /**
+     * Returns the offsets at which the messages start.
+     */
+    const std::vector<std::size_t> & offsets() noexcept
+    {
+        discard_incomplete();
+        return m_offsets;
     }
 
     /**
-     * Serialize a polymorphic type, in case of a loading (input) archive.
+     * Returns the number of messages.
      */
-    template <typename...,
-              typename ArchiveType = Archive,
-              typename = typename ArchiveType::loading>
-    void serialize(Archive & archive,
-                   std::unique_ptr<polymorphic> & object)
+    std::size_t size() const noexcept
     {
-        id_type id{};
+        return m_offsets.size() - m_incomplete;
+    }
 
-        // Load the serialization id.
-        archive(id);
+    /**
+     * Returns the data pointer.
+     */
+    using base::data;
 
-        // Lock the serialization method maps for read access.
-        std::shared_lock<shared_mutex> lock(m_shared_mutex);
+    /**
+     * Returns the current offset in the data.
+     */
+    using base::offset;
 
-        // Find the serialization method.
-        auto serialization_id_to_method_pair =
-            m_serialization_id_to_method.find(id);
-        if (m_serialization_id_to_method.end() ==
-            serialization_id_to_method_pair) {
-            throw undeclared_polymorphic_type_error(
-                "Undeclared polymorphic serialization type error.");
+private:
+    /**
+     * Discards a message that failed to serialize.
+     */
+    void discard_incomplete() noexcept
+    {
+        if (m_incomplete) {
+            this->reset(m_offsets.back());
+            m_offsets.pop_back();
+            m_incomplete = false;
         }
+    }
 
-        // Fetch the serialization method.
-        auto serialization_method =
-            serialization_id_to_method_pair->second;
+    /**
+     * The offsets at which the messages start.
+     */
+    std::vector<std::size_t> m_offsets;
 
-        // Unlock the serialization method maps.
-        lock.unlock();
+    /**
+     * Whether the last message failed to serialize.
+     */
+    bool m_incomplete{};
+};
 
-        // Serialize (load) the given object.
-        serialization_method(archive, object);
+namespace detail
+{
+/**
+ * Computes the XXH64 hash of a stream of bytes.
+ */
+class xxhash64
+{
+public:
+    /**
+     * Constructs the hash state with the given seed.
+     */
+    explicit xxhash64(std::uint64_t seed = {}) noexcept
+    {
+        reset(seed);
     }
 
     /**
-     * Serialize a polymorphic type, in case of a saving (output) archive.
+     * Resets the hash state with the given seed.
      */
-    template <typename...,
-              typename ArchiveType = Archive,
-              typename = typename ArchiveType::saving>
-    void serialize(Archive & archive, const polymorphic & object)
+    void reset(std::uint64_t seed = {}) noexcept
     {
-        // Lock the serialization method maps for read access.
-        std::shared_lock<shared_mutex> lock(m_shared_mutex);
+        m_seed = seed;
+        m_accumulators[0] = seed + prime1 + prime2;
+        m_accumulators[1] = seed + prime2;
+        m_accumulators[2] = seed;
+        m_accumulators[3] = seed - prime1;
+        m_buffer_size = 0;
+        m_total_size = 0;
+    }
 
-        // Find the serialization id.
-        auto type_information_to_serialization_id_pair =
-            m_type_information_to_serialization_id.find(
-                typeid(object).name());
-        if (m_type_information_to_serialization_id.end() ==
-            type_information_to_serialization_id_pair) {
-            throw undeclared_polymorphic_type_error(
-                "Undeclared polymorphic serialization type error.");
+    /**
+     * Adds the given bytes to the hash.
+     */
+    void update(const unsigned char * data, std::size_t size) noexcept
+    {
+        m_total_size += size;
+
+        // Complete the buffered stripe, if any.
+        if (m_buffer_size) {
+            auto count = std::min(size, stripe_size - m_buffer_size);
+            std::copy_n(data, count, m_buffer + m_buffer_size);
+            m_buffer_size += count;
+            data += count;
+            size -= count;
+            if (m_buffer_size < stripe_size) {
+                return;
+            }
+            consume_stripe(m_buffer);
+            m_buffer_size = 0;
         }
 
-        // Fetch the serialization id.
-        auto id = type_information_to_serialization_id_pair->second;
-
-        // Find the serialization method.
-        auto serialization_id_to_method_pair =
-            m_serialization_id_to_method.find(id);
-        if (m_serialization_id_to_method.end() ==
-            serialization_id_to_method_pair) {
-            throw undeclared_polymorphic_type_error(
-                "Undeclared polymorphic serialization type error.");
+        // Consume whole stripes directly from the data.
+        for (; size >= stripe_size; data += stripe_size, size -= stripe_size) {
+            consume_stripe(data);
         }
 
-        // Fetch the serialization method.
-        auto serialization_method =
-            serialization_id_to_method_pair->second;
+        // Buffer the rest.
+        std::copy_n(data, size, m_buffer);
+        m_buffer_size = size;
+    }
 
-        // Unlock the serialization method maps.
-        lock.unlock();
+    /**
+     * Returns the hash of the bytes added so far.
+     */
+    std::uint64_t digest() const noexcept
+    {
+        std::uint64_t hash{};
+        if (m_total_size >= stripe_size) {
+            hash = rotate_left(m_accumulators[0], 1) +
+                   rotate_left(m_accumulators[1], 7) +
+                   rotate_left(m_accumulators[2], 12) +
+                   rotate_left(m_accumulators[3], 18);
+            for (auto accumulator : m_accumulators) {
+                hash ^= round(0, accumulator);
+                hash = hash * prime1 + prime4;
+            }
+        } else {
+            hash = m_seed + prime5;
+        }
 
-        // Serialize (save) the serialization id.
-        archive(id);
+        hash += m_total_size;
 
-        // Serialize (save) the given object.
-        serialization_method(archive, object);
+        // Mix the buffered bytes.
+        std::size_t offset{};
+        for (; offset + 8 <= m_buffer_size; offset += 8) {
+            hash ^= round(0, read_little_endian<std::uint64_t>(
+                                 m_buffer + offset));
+            hash = rotate_left(hash, 27) * prime1 + prime4;
+        }
+        if (offset + 4 <= m_buffer_size) {
+            hash ^= read_little_endian<std::uint32_t>(m_buffer + offset) *
+                    prime1;
+            hash = rotate_left(hash, 23) * prime2 + prime3;
+            offset += 4;
+        }
+        for (; offset < m_buffer_size; ++offset) {
+            hash ^= m_buffer[offset] * prime5;
+            hash = rotate_left(hash, 11) * prime1;
+        }
+
+        // Avalanche.
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
     }
 
 private:
     /**
-     * Default constructor, defaulted.
+     * The XXH64 primes.
      */
-    registry() = default;
+    static constexpr std::uint64_t prime1 = 0x9e3779b185ebca87;
+    static constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+    static constexpr std::uint64_t prime3 = 0x165667b19e3779f9;
+    static constexpr std::uint64_t prime4 = 0x85ebca77c2b2ae63;
+    static constexpr std::uint64_t prime5 = 0x27d4eb2f165667c5;
 
-private:
     /**
-     * The shared mutex that protects the maps below.
+     * The number of bytes consumed at a time.
      */
-    shared_mutex m_shared_mutex;
+    static constexpr std::size_t stripe_size = 32;
 
     /**
-     * A map between serialization id to method.
+     * Reads an integer stored in little endian byte order.
      */
-    std::unordered_map<id_type, serialization_method_t<Archive>>
-        m_serialization_id_to_method;
+    template <typename Integer>
+    static Integer read_little_endian(const unsigned char * data) noexcept
+    {
+        Integer value{};
+        for (std::size_t index{}; index < sizeof(Integer); ++index) {
+            value |= Integer(data[index]) << (index * 8);
+        }
+        return value;
+    }
 
     /**
-     * A map between type information string to serialization id.
+     * Mixes the input into the accumulator.
      */
-    std::unordered_map<std::string, id_type>
-        m_type_information_to_serialization_id;
-};     // registry
-#endif // ZPP_SERIALIZER_FREESTANDING
-
-/**
- * Serialize resizable containers, operates on loading (input) archives.
- */
-template <
-    typename Archive,
-    typename Container,
-    typename SizeType = size_type,
-    typename...,
-    typename = decltype(std::declval<Container &>().size()),
-    typename = decltype(std::declval<Container &>().begin()),
-    typename = decltype(std::declval<Container &>().end()),
-    typename = decltype(std::declval<Container &>().resize(std::size_t())),
-    typename = std::enable_if_t<
-        std::is_class<typename Container::value_type>::value ||
-        !std::is_base_of<
-            std::random_access_iterator_tag,
-            typename std::iterator_traits<
-                typename Container::iterator>::iterator_category>::value>,
-    typename = typename Archive::loading,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void>
-auto serialize(Archive & archive, Container & container)
-{
-    SizeType size{};
-
-    // Fetch the number of items to load.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
+    static std::uint64_t round(std::uint64_t accumulator,
+                               std::uint64_t input) noexcept
+    {
+        accumulator += input * prime2;
+        accumulator = rotate_left(accumulator, 31);
+        return accumulator * prime1;
     }
-#endif
-
-    // Resize the container to match the size.
-    container.resize(size);
 
-    // Serialize all the items.
-    for (auto & item : container) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
+    /**
+     * Consumes a stripe into the accumulators.
+     */
+    void consume_stripe(const unsigned char * data) noexcept
+    {
+        for (std::size_t index{}; index < 4; ++index) {
+            m_accumulators[index] = round(
+                m_accumulators[index],
+                read_little_endian<std::uint64_t>(data + index * 8));
         }
-#endif
     }
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+    /**
+     * The seed.
+     */
+    std::uint64_t m_seed{};
 
-/**
- * Serialize containers, operates on saving (output) archives.
- */
-template <
-    typename Archive,
-    typename Container,
-    typename SizeType = size_type,
-    typename...,
-    typename = decltype(std::declval<Container &>().size()),
-    typename = decltype(std::declval<Container &>().begin()),
-    typename = decltype(std::declval<Container &>().end()),
-    typename = std::enable_if_t<
-        std::is_class<typename Container::value_type>::value ||
-        !std::is_base_of<
-            std::random_access_iterator_tag,
-            typename std::iterator_traits<
-                typename Container::iterator>::iterator_category>::value ||
-        !detail::has_data_member_function<Container>::value>,
-    typename = typename Archive::saving,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void>
-auto serialize(Archive & archive, const Container & container)
-{
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    // Save the container size.
-    archive(static_cast<SizeType>(container.size()));
-#else
-    if (auto result = archive(static_cast<SizeType>(container.size()));
-        !result) {
-        return result;
-    }
-#endif
+    /**
+     * The accumulators.
+     */
+    std::uint64_t m_accumulators[4]{};
 
-    // Serialize all the items.
-    for (auto & item : container) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
-        }
-#endif
-    }
+    /**
+     * The bytes that do not yet complete a stripe.
+     */
+    unsigned char m_buffer[stripe_size]{};
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+    /**
+     * The number of buffered bytes.
+     */
+    std::size_t m_buffer_size{};
+
+    /**
+     * The total number of bytes added.
+     */
+    std::uint64_t m_total_size{};
+};
+} // namespace detail
 
 /**
- * Serialize view containers, operates on loading (input) archives.
+ * This archive serves as an output archive, which computes a hash of the
+ * serialized data, rather than saving it. The hash equals the XXH64 hash
+ * of the bytes that a memory output archive would save, and is computed
+ * without allocating them.
+ * Example:
+ * ~~~
+ * zpp::serializer::hashing_archive hasher;
+ * hasher(object);
+ * auto fingerprint = hasher.hash();
+ * ~~~
  */
-template <
-    typename Archive,
-    typename Container,
-    typename SizeType = size_type,
-    typename...,
-    typename = decltype(std::declval<Container &>().size()),
-    typename = decltype(std::declval<Container &>().begin()),
-    typename = decltype(std::declval<Container &>().end()),
-    typename =
-        std::enable_if_t<std::is_trivially_destructible<Container>::value>,
-    typename = std::enable_if_t<
-        std::is_class<typename Container::value_type>::value ||
-        !std::is_base_of<
-            std::random_access_iterator_tag,
-            typename std::iterator_traits<
-                typename Container::iterator>::iterator_category>::value>,
-    typename = typename Archive::loading,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void>
-auto serialize(Archive & archive, Container & container)
+class hashing_archive : public archive<hashing_archive>
 {
-    SizeType size{};
+public:
+    /**
+     * The base archive.
+     */
+    using base = archive<hashing_archive>;
 
-    // Fetch the number of items to load.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
+    /**
+     * Declare base as friend.
+     */
+    friend base;
+
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Constructs a hashing archive with the given seed.
+     */
+    explicit hashing_archive(std::uint64_t seed = {}) noexcept :
+        m_hash(seed)
+    {
     }
-#endif
 
-    // Check size.
-    if (size > container.size()) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        throw out_of_range("View type container out of range.");
-#else
-        return freestanding::error{error::out_of_range};
-#endif
+    /**
+     * Returns the hash of the data serialized so far.
+     */
+    std::uint64_t hash() const noexcept
+    {
+        return m_hash.digest();
     }
 
-    // Resize the view container to match the size.
-    container = {container.data(), size};
+    /**
+     * Resets the hash with the given seed.
+     */
+    void reset(std::uint64_t seed = {}) noexcept
+    {
+        m_hash.reset(seed);
+    }
 
-    // Serialize all the items.
-    for (auto & item : container) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
-        }
-#endif
+protected:
+    /**
+     * Serialize a single item - hash its data.
+     */
+    template <typename Item>
+    auto serialize(Item && item)
+    {
+        m_hash.update(
+            reinterpret_cast<const unsigned char *>(std::addressof(item)),
+            sizeof(item));
 
 #ifdef ZPP_SERIALIZER_FREESTANDING
         return freestanding::error{error::success};
 #endif
     }
-}
-
-/**
- * Serialize resizable, continuous containers, of fundamental or
- * enumeration types. Operates on loading (input) archives.
- */
-template <
-    typename Archive,
-    typename Container,
-    typename SizeType = size_type,
-    typename...,
-    typename = decltype(std::declval<Container &>().size()),
-    typename = decltype(std::declval<Container &>().begin()),
-    typename = decltype(std::declval<Container &>().end()),
-    typename = decltype(std::declval<Container &>().resize(std::size_t())),
-    typename = decltype(std::declval<Container &>().data()),
-    typename = std::enable_if_t<
-        std::is_fundamental<typename Container::value_type>::value ||
-        std::is_enum<typename Container::value_type>::value>,
-    typename = std::enable_if_t<std::is_base_of<
-        std::random_access_iterator_tag,
-        typename std::iterator_traits<
-            typename Container::iterator>::iterator_category>::value>,
-    typename = typename Archive::loading,
-    typename = void,
-    typename = void,
-    typename = void,
-    typename = void>
-auto serialize(Archive & archive, Container & container)
-{
-    SizeType size{};
-
-    // Fetch the number of items to load.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
-    }
-#endif
 
-    // Resize the container to match the size.
-    container.resize(size);
+    /**
+     * Serialize bytes data - hash its data.
+     */
+    auto serialize(const void * data, std::size_t size)
+    {
+        m_hash.update(static_cast<const unsigned char *>(data), size);
 
-    // If the size is zero, return.
-    if (!size) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        return;
-#else
+#ifdef ZPP_SERIALIZER_FREESTANDING
         return freestanding::error{error::success};
 #endif
     }
 
-    // Serialize the bytes data.
-    return archive(as_bytes(std::addressof(container[0]),
-                            static_cast<SizeType>(container.size())));
-}
+private:
+    /**
+     * The hash state.
+     */
+    detail::xxhash64 m_hash;
+};
 
 /**
- * Serialize continuous containers, of fundamental or
- * enumeration types. Operates on saving (output) archives.
+ * Returns the hash of the given items, as computed by hashing_archive.
  */
-template <typename Archive,
-          typename Container,
-          typename SizeType = size_type,
-          typename...,
-          typename = decltype(std::declval<Container &>().size()),
-          typename = decltype(std::declval<Container &>().begin()),
-          typename = decltype(std::declval<Container &>().end()),
-          typename = decltype(std::declval<Container &>().data()),
-          typename = std::enable_if_t<
-              std::is_fundamental<typename Container::value_type>::value ||
-              std::is_enum<typename Container::value_type>::value>,
-          typename = std::enable_if_t<std::is_base_of<
-              std::random_access_iterator_tag,
-              typename std::iterator_traits<typename Container::iterator>::
-                  iterator_category>::value>,
-          typename = typename Archive::saving,
-          typename = void,
-          typename = void,
-          typename = void,
-          typename = void,
-          typename = void>
-auto serialize(Archive & archive, const Container & container)
+template <typename... Items>
+std::uint64_t hash_of(const Items &... items)
 {
-    // The container size.
-    auto size = static_cast<SizeType>(container.size());
+    hashing_archive hasher;
+    hasher(items...);
+    return hasher.hash();
+}
 
-    // Save the container size.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
+/**
+ * This archive serves as an output archive, which compares the serialized
+ * data against previously serialized bytes, rather than saving it.
+ * Comparison stops at the first mismatch, after which serialization does
+ * nothing, and items are no longer traversed.
+ * Example:
+ * ~~~
+ * zpp::serializer::equality_archive compare(previous_bytes);
+ * compare(object);
+ * if (compare.equal()) {
+ *     // Unchanged.
+ * }
+ * ~~~
+ */
+class equality_archive : public archive<equality_archive>
+{
+public:
+    /**
+     * The base archive.
+     */
+    using base = archive<equality_archive>;
+
+    /**
+     * Declare base as friend.
+     */
+    friend base;
+
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Constructs an equality archive, that compares against the given
+     * bytes.
+     */
+    equality_archive(const unsigned char * data,
+                     std::size_t size) noexcept :
+        m_data(data),
+        m_size(size)
+    {
     }
-#endif
 
-    // If the size is zero, return.
-    if (!size) {
+    /**
+     * Constructs an equality archive, that compares against the given
+     * bytes.
+     */
+    explicit equality_archive(
+        const std::vector<unsigned char> & data) noexcept :
+        equality_archive(data.data(), data.size())
+    {
+    }
+
+    /**
+     * Compares the given items, unless a mismatch was already found, in
+     * which case the items are not traversed at all.
+     */
+    template <typename... Items>
+    auto operator()(Items &&... items)
+    {
+        if (m_mismatch) {
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        return;
+            return;
 #else
-        return freestanding::error{error::success};
+            return freestanding::error{error::success};
 #endif
+        }
+
+        return base::operator()(std::forward<Items>(items)...);
     }
 
-    // Serialize the bytes data.
-    return archive(as_bytes(std::addressof(container[0]),
-                            static_cast<SizeType>(container.size())));
-}
+    /**
+     * Returns true if the data serialized so far matches the bytes, and
+     * all the bytes were compared.
+     */
+    bool equal() const noexcept
+    {
+        return !m_mismatch && m_offset == m_size;
+    }
 
-/**
- * Serialize continuous view containers, of fundamental or
- * enumeration types. Operates on loading (input) archives.
- */
-template <typename Archive,
-          typename Container,
-          typename SizeType = size_type,
-          typename...,
-          typename = decltype(std::declval<Container &>().size()),
-          typename = decltype(std::declval<Container &>().begin()),
-          typename = decltype(std::declval<Container &>().end()),
-          typename = decltype(std::declval<Container &>().data()),
-          typename = std::enable_if_t<
-              std::is_trivially_destructible<Container>::value>,
-          typename = std::enable_if_t<
-              std::is_fundamental<typename Container::value_type>::value ||
-              std::is_enum<typename Container::value_type>::value>,
-          typename = std::enable_if_t<std::is_base_of<
-              std::random_access_iterator_tag,
-              typename std::iterator_traits<typename Container::iterator>::
-                  iterator_category>::value>,
-          typename = typename Archive::loading,
-          typename = void,
-          typename = void,
-          typename = void,
-          typename = void,
-          typename = void>
-auto serialize(Archive & archive, Container & container)
-{
-    SizeType size{};
+    /**
+     * Returns true if the data serialized so far does not match the
+     * bytes.
+     */
+    bool mismatch() const noexcept
+    {
+        return m_mismatch;
+    }
 
-    // Fetch the number of items to load.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
+    /**
+     * Returns the offset of the next byte to compare.
+     */
+    std::size_t offset() const noexcept
+    {
+        return m_offset;
     }
-#endif
 
-    // Check the size.
-    if (size > container.size()) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        throw out_of_range("View type container out of range.");
-#else
-        return freestanding::error{error::out_of_range};
-#endif
+    /**
+     * Resets the comparison to the given offset, which is clamped to the
+     * number of bytes to compare against.
+     */
+    void reset(std::size_t offset = {}) noexcept
+    {
+        m_offset = std::min(offset, m_size);
+        m_mismatch = false;
     }
 
-    // Resize the view container to match the size.
-    container = {container.data(), size};
+protected:
+    /**
+     * Serialize a single item - compare its data.
+     */
+    template <typename Item>
+    auto serialize(Item && item)
+    {
+        return serialize(std::addressof(item), sizeof(item));
+    }
 
-    // If the size is zero, return.
-    if (!size) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        return;
-#else
+    /**
+     * Serialize bytes data - compare its data.
+     */
+    auto serialize(const void * data, std::size_t size)
+    {
+        if (!m_mismatch) {
+            if (size > m_size - m_offset ||
+                (size && std::memcmp(m_data + m_offset, data, size))) {
+                m_mismatch = true;
+            } else {
+                m_offset += size;
+            }
+        }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
         return freestanding::error{error::success};
 #endif
     }
 
-    // Serialize the bytes data.
-    return archive(as_bytes(std::addressof(container[0]),
-                            static_cast<SizeType>(container.size())));
-}
+private:
+    /**
+     * The bytes to compare against.
+     */
+    const unsigned char * m_data{};
+
+    /**
+     * The number of bytes to compare against.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The offset of the next byte to compare.
+     */
+    std::size_t m_offset{};
+
+    /**
+     * Whether a mismatch was found.
+     */
+    bool m_mismatch{};
+};
 
 /**
- * Serialize Associative and UnorderedAssociative containers, operates on
- * loading (input) archives.
+ * This archive serves as an input archive, that loads data from a view,
+ * like memory_view_input_archive, but records errors in a sticky flag
+ * rather than reporting every one of them. Once a load overflows the
+ * input, the archive is failed, the offset is moved to the end, and
+ * further loads are served zeroes, so loads never branch on errors, and
+ * the caller checks failed() once at the end.
+ * Container sizes larger than the remaining input fail the archive as
+ * well, and load no items, so that nothing is allocated for them.
  */
-template <typename Archive,
-          typename Container,
-          typename SizeType = size_type,
-          typename...,
-          typename = decltype(std::declval<Container &>().size()),
-          typename = decltype(std::declval<Container &>().begin()),
-          typename = decltype(std::declval<Container &>().end()),
-          typename = typename Container::value_type,
-          typename = typename Container::key_type,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, Container & container)
+class sticky_memory_view_input_archive
+    : public archive<sticky_memory_view_input_archive>
 {
-    SizeType size{};
+public:
+    /**
+     * The base archive.
+     */
+    using base = archive<sticky_memory_view_input_archive>;
 
-    // Fetch the number of items to load.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(size);
-#else
-    if (auto result = archive(size); !result) {
-        return result;
+    /**
+     * Declare base as friend.
+     */
+    friend base;
+
+    /**
+     * Loading archive.
+     */
+    using loading = void;
+
+    /**
+     * Constructs a sticky memory view input archive, that loads data from
+     * an array of given pointer and size.
+     */
+    sticky_memory_view_input_archive(const unsigned char * input,
+                                     std::size_t size) noexcept :
+        m_input(input),
+        m_size(size)
+    {
     }
-#endif
 
-    // Serialize all the items.
-    for (SizeType i{}; i < size; ++i) {
-        // Deduce the container item type.
-        using item_type =
-            detail::container_nonconst_value_type_t<Container>;
+    /**
+     * Constructs a sticky memory view input archive, that loads data from
+     * the given vector.
+     */
+    explicit sticky_memory_view_input_archive(
+        const std::vector<unsigned char> & input) noexcept :
+        sticky_memory_view_input_archive(input.data(), input.size())
+    {
+    }
 
-        // Create just enough storage properly aligned for one item.
-        std::aligned_storage_t<sizeof(item_type), alignof(item_type)>
-            storage;
+    /**
+     * Returns true if a load overflowed the input, since the archive was
+     * constructed or reset.
+     */
+    bool failed() const noexcept
+    {
+        return m_failed;
+    }
 
-        // Create the object at the storage.
-        std::unique_ptr<item_type, void (*)(item_type *)> object(
-            access::placement_new<item_type>(std::addressof(storage)),
-            [](auto pointer) { access::destruct(*pointer); });
+    /**
+     * Marks the archive as failed, as when a load overflows the input.
+     */
+    void fail() noexcept
+    {
+        m_failed = true;
+        m_offset = m_size;
+    }
 
-        // Serialize the object.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(*object);
-#else
-        if (auto result = archive(*object); !result) {
-            return result;
-        }
-#endif
+    /**
+     * Returns the input data.
+     */
+    const unsigned char * data() const noexcept
+    {
+        return m_input;
+    }
+
+    /**
+     * Returns the current offset in the input data.
+     */
+    std::size_t offset() const noexcept
+    {
+        return m_offset;
+    }
+
+    /**
+     * Resets the serialization to offset, and clears the failure, to
+     * allow advanced use.
+     */
+    void reset(std::size_t offset = {}) noexcept
+    {
+        m_offset = offset;
+        m_failed = false;
+    }
 
-        // Insert the item to the container.
-        container.insert(std::move(*object));
+    /**
+     * Returns the number of input bytes remaining to be loaded.
+     */
+    std::size_t remaining() const noexcept
+    {
+        return m_size - m_offset;
     }
 
+protected:
+    /**
+     * Serialize a single item - load it from the input, or from the
+     * zeroed scratch area if it does not fit.
+     */
+    template <typename Item>
+    auto serialize(Item && item)
+    {
+        static_assert(sizeof(item) <= sizeof(m_scratch),
+                      "Item does not fit in the scratch area.");
+
+        // Select the input, or the scratch area, without branching.
+        bool fits = sizeof(item) <= m_size - m_offset;
+        auto input = fits ? m_input + m_offset : m_scratch;
+        m_failed |= !fits;
+        m_offset = fits ? m_offset + sizeof(item) : m_size;
+
+        // Fetch the item.
+        std::memcpy(std::addressof(item), input, sizeof(item));
+
 #ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
+        return freestanding::error{error::success};
 #endif
-}
+    }
 
-/**
- * Serialize arrays, operates on loading (input) archives.
- * This overload is for non fundamental non enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
+    /**
+     * Serializes bytes data - load it from the input, or zero it if it
+     * does not fit.
+     */
+    auto serialize(void * data, std::size_t size)
+    {
+        if (size <= m_size - m_offset) {
+            std::memcpy(data, m_input + m_offset, size);
+            m_offset += size;
+        } else {
+            std::memset(data, 0, size);
+            m_failed = true;
+            m_offset = m_size;
+        }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+private:
+    /**
+     * The input data.
+     */
+    const unsigned char * m_input{};
+
+    /**
+     * The input size.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The next input.
+     */
+    std::size_t m_offset{};
+
+    /**
+     * Whether a load overflowed the input.
+     */
+    bool m_failed{};
+
+    /**
+     * The zeroed scratch area that overflowing items are loaded from.
+     */
+    unsigned char m_scratch[sizeof(long double)]{};
+};
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * This archive serves as an input archive, that validates and skips
+ * serialized data without constructing it, to find where a message ends
+ * or check that it is well formed, at a fraction of the cost of loading.
+ * Fundamental types and bytes loaded into buffers are loaded, containers
+ * of items of fixed serialized size and strings are skipped in one step,
+ * and other items are skipped by walking a default constructed object of
+ * their type, kept per thread, whose containers are never resized.
+ * Compressed floating point and segmented containers are skipped by
+ * their sizes. Polymorphic objects are skipped by the skip method
+ * registered for their id.
+ * Data saved with a string dictionary or an object tracker cannot be
+ * skipped. In sticky mode, set by make_sticky(), input that is not large
+ * enough marks the archive as failed, instead of throwing.
+ */
+class skipping_archive : public archive<skipping_archive>
+{
+public:
+    /**
+     * The base archive.
+     */
+    using base = archive<skipping_archive>;
+
+    /**
+     * Declare base as friend.
+     */
+    friend base;
+
+    /**
+     * Loading archive.
+     */
+    using loading = void;
+
+    /**
+     * Constructs a skipping archive, that skips data from an array of
+     * given pointer and size.
+     */
+    skipping_archive(const unsigned char * input,
+                     std::size_t size) noexcept :
+        m_input(input),
+        m_size(size)
+    {
+    }
+
+    /**
+     * Constructs a skipping archive, that skips data from the given
+     * vector.
+     */
+    explicit skipping_archive(
+        const std::vector<unsigned char> & input) noexcept :
+        skipping_archive(input.data(), input.size())
+    {
+    }
+
+    /**
+     * Skips an item of the given type.
+     */
+    template <typename Item>
+    void skip()
+    {
+        (*this)(detail::skipped_object<Item>());
+    }
+
+    /**
+     * Skips the given number of bytes.
+     */
+    void advance(std::size_t size)
+    {
+        if (size > m_size - m_offset) {
+            fail();
+            return;
+        }
+        m_offset += size;
+    }
+
+    /**
+     * Makes input that is not large enough mark the archive as failed,
+     * as in sticky_memory_view_input_archive, instead of throwing.
+     */
+    void make_sticky() noexcept
+    {
+        m_sticky = true;
+    }
+
+    /**
+     * Returns true if the input was not large enough, in sticky mode.
+     */
+    bool failed() const noexcept
+    {
+        return m_failed;
+    }
+
+    /**
+     * Fails the skipping, that throws unless in sticky mode, where it
+     * marks the archive as failed, and moves to the end of the input.
+     */
+    void fail()
+    {
+        if (!m_sticky) {
+            throw out_of_range("Input was not large enough to contain the "
+                               "skipped item");
+        }
+        m_failed = true;
+        m_offset = m_size;
+    }
+
+    /**
+     * Returns the input data.
+     */
+    const unsigned char * data() const noexcept
+    {
+        return m_input;
+    }
+
+    /**
+     * Returns the current offset in the input data.
+     */
+    std::size_t offset() const noexcept
+    {
+        return m_offset;
+    }
+
+    /**
+     * Resets the skipping to offset, to allow advanced use, and clears
+     * the failure.
+     */
+    void reset(std::size_t offset = {}) noexcept
+    {
+        m_offset = offset;
+        m_failed = false;
+    }
+
+    /**
+     * Returns the number of input bytes remaining to be skipped.
+     */
+    std::size_t remaining() const noexcept
+    {
+        return m_size - m_offset;
+    }
+
+protected:
+    /**
+     * Serialize a single item - load it, since sizes, indices and ids
+     * decide what is skipped next.
+     */
+    template <typename Item>
+    void serialize(Item && item)
+    {
+        auto input = m_input + m_offset;
+        advance(sizeof(item));
+        if (m_failed) {
+            std::memset(std::addressof(item), 0, sizeof(item));
+            return;
+        }
+        std::memcpy(std::addressof(item), input, sizeof(item));
+    }
+
+    /**
+     * Serialize bytes data - load it, since it is loaded only into
+     * buffers that are decoded, while containers of bytes are skipped
+     * without loading.
+     */
+    void serialize(void * data, std::size_t size)
+    {
+        auto input = m_input + m_offset;
+        advance(size);
+        if (m_failed) {
+            std::memset(data, 0, size);
+            return;
+        }
+        std::memcpy(data, input, size);
+    }
+
+private:
+    /**
+     * The input data.
+     */
+    const unsigned char * m_input{};
+
+    /**
+     * The input size.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The offset of the next byte to skip.
+     */
+    std::size_t m_offset{};
+
+    /**
+     * Whether input that is not large enough fails the archive instead
+     * of throwing.
+     */
+    bool m_sticky{};
+
+    /**
+     * Whether the input was not large enough, in sticky mode.
+     */
+    bool m_failed{};
+};
+#endif
+
+/**
+ * Reads a batch of messages written by batch_writer, given the data and
+ * the offsets at which the messages start, by handing out a memory view
+ * input archive per message.
+ */
+class batch_reader
+{
+public:
+    /**
+     * Constructs a batch reader from the data and the message offsets.
+     */
+    batch_reader(const unsigned char * data,
+                 std::size_t size,
+                 const std::vector<std::size_t> & offsets) noexcept :
+        m_data(data),
+        m_size(size),
+        m_offsets(std::addressof(offsets))
+    {
+    }
+
+    /**
+     * Constructs a batch reader from the data and the message offsets.
+     */
+    batch_reader(const std::vector<unsigned char> & data,
+                 const std::vector<std::size_t> & offsets) noexcept :
+        batch_reader(data.data(), data.size(), offsets)
+    {
+    }
+
+    /**
+     * Returns the number of messages.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_offsets->size();
+    }
+
+    /**
+     * Returns an input archive for the message at the given index.
+     * Indices or offsets that are out of range give an empty archive.
+     */
+    memory_view_input_archive operator[](std::size_t index) const noexcept
+    {
+        auto & offsets = *m_offsets;
+        if (index >= offsets.size()) {
+            return {m_data, 0};
+        }
+        auto begin = offsets[index];
+        auto end = index + 1 < offsets.size() ? offsets[index + 1] : m_size;
+        if (begin > end || end > m_size) {
+            return {m_data, 0};
+        }
+        return {m_data + begin, end - begin};
+    }
+
+private:
+    /**
+     * The data of the messages.
+     */
+    const unsigned char * m_data{};
+
+    /**
+     * The size of the data.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The offsets at which the messages start.
+     */
+    const std::vector<std::size_t> * m_offsets{};
+};
+
+namespace detail
+{
+/**
+ * The archive that is passed to serialize methods by the given archive.
+ */
+template <typename Archive>
+struct serializing_archive
+{
+    using type = Archive;
+};
+
+/**
+ * The archive that is passed to serialize methods by the given archive.
+ */
+template <>
+struct serializing_archive<memory_output_archive>
+{
+    using type = basic_memory_output_archive;
+};
+
+/**
+ * The archive that is passed to serialize methods by the given archive.
+ */
+template <>
+struct serializing_archive<memory_view_output_archive>
+{
+    using type = basic_memory_output_archive;
+};
+
+/**
+ * The archive that is passed to serialize methods by the given archive.
+ */
+template <>
+struct serializing_archive<memory_input_archive>
+{
+    using type = memory_view_input_archive;
+};
+
+/**
+ * The archive that is passed to serialize methods by the given archive.
+ */
+template <typename Archive>
+using serializing_archive_t = typename serializing_archive<Archive>::type;
+} // namespace detail
+
+/**
+ * Declares that serialization of 'Type' with 'Archive' is explicitly
+ * instantiated in another translation unit, using
+ * ZPP_SERIALIZER_INSTANTIATE_SERIALIZATION, so that including
+ * translation units do not instantiate it.
+ * Use in the global namespace, after the declaration of 'Type', whose
+ * serialize method should declare its result type, since deducing the
+ * result type instantiates the method.
+ * Example:
+ * ~~~
+ * // message.h
+ * ZPP_SERIALIZER_EXTERN_SERIALIZATION(zpp::serializer::memory_output_archive,
+ *                                     protocol::message);
+ *
+ * // message.cpp
+ * ZPP_SERIALIZER_INSTANTIATE_SERIALIZATION(
+ *     zpp::serializer::memory_output_archive, protocol::message);
+ * ~~~
+ */
+#define ZPP_SERIALIZER_EXTERN_SERIALIZATION(Archive, Type)                  \
+    namespace zpp                                                            \
+    {                                                                        \
+    namespace serializer                                                     \
+    {                                                                        \
+    namespace detail                                                         \
+    {                                                                        \
+    template <>                                                              \
+    struct is_extern_serialization<                                          \
+        serializing_archive_t<Archive>,                                      \
+        serialized_type_t<serializing_archive_t<Archive>, Type>>             \
+        : std::true_type                                                     \
+    {                                                                        \
+    };                                                                       \
+    }                                                                        \
+    }                                                                        \
+    }                                                                        \
+    extern template ::zpp::serializer::detail::serialization_result_t        \
+    ::zpp::serializer::detail::serialize_instance(                          \
+        ::zpp::serializer::detail::serializing_archive_t<Archive> &,         \
+        ::zpp::serializer::detail::serialized_type_t<                        \
+            ::zpp::serializer::detail::serializing_archive_t<Archive>,       \
+            Type> &)
+
+/**
+ * Explicitly instantiates serialization of 'Type' with 'Archive', that
+ * is declared by ZPP_SERIALIZER_EXTERN_SERIALIZATION.
+ * Use in the global namespace, in a single translation unit.
+ */
+#define ZPP_SERIALIZER_INSTANTIATE_SERIALIZATION(Archive, Type)             \
+    template ::zpp::serializer::detail::serialization_result_t               \
+    ::zpp::serializer::detail::serialize_instance(                          \
+        ::zpp::serializer::detail::serializing_archive_t<Archive> &,         \
+        ::zpp::serializer::detail::serialized_type_t<                        \
+            ::zpp::serializer::detail::serializing_archive_t<Archive>,       \
+            Type> &)
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * This class manages polymorphic type registration for serialization
+ * process.
+ */
+template <typename Archive>
+class registry
+{
+public:
+    static_assert(!std::is_reference<Archive>::value,
+                  "Disallows reference type for archive in registry");
+
+    /**
+     * Returns the global instance of the registry.
+     */
+    static registry & get_instance() noexcept
+    {
+        static registry registry;
+        return registry;
+    }
+
+    /**
+     * Add a serialization method for a given polymorphic type and id.
+     */
+    template <typename Type, id_type id>
+    void add()
+    {
+        add<Type>(id);
+    }
+
+    /**
+     * Adds a serialization method for a given polymorphic type and id.
+     */
+    template <typename Type>
+    void add(id_type id)
+    {
+        add(id,
+            typeid(Type).name(),
+            make_serialization_method<Archive, Type>());
+    }
+
+    /**
+     * Add a serialization method for a given polymorphic type information
+     * string and id. The behavior is undefined if the type isn't derived
+     * from polymorphic.
+     */
+    void add(id_type id,
+             std::string type_information_string,
+             serialization_method_t<Archive> serialization_method)
+    {
+        // Lock the serialization method maps for write access.
+        std::lock_guard<shared_mutex> lock(m_shared_mutex);
+
+        // Add the serialization id to serialization method mapping.
+        m_serialization_id_to_method.emplace(
+            id, std::move(serialization_method));
+
+        // Add the type information to to serialization id mapping.
+        m_type_information_to_serialization_id.emplace(
+            std::move(type_information_string), id);
+    }
+
+    /**
+     * Serialize a polymorphic type, in case of a loading (input) archive.
+     */
+    template <typename...,
+              typename ArchiveType = Archive,
+              typename = typename ArchiveType::loading>
+    void serialize(Archive & archive,
+                   std::unique_ptr<polymorphic> & object)
+    {
+        id_type id{};
+
+        // Load the serialization id.
+        archive(id);
+
+        // Archives with sticky errors load no object once failed.
+        if (detail::failed_of(archive, 0)) {
+            return;
+        }
+
+        // Lock the serialization method maps for read access.
+        std::shared_lock<shared_mutex> lock(m_shared_mutex);
+
+        // Find the serialization method.
+        auto serialization_id_to_method_pair =
+            m_serialization_id_to_method.find(id);
+        if (m_serialization_id_to_method.end() ==
+            serialization_id_to_method_pair) {
+            throw undeclared_polymorphic_type_error(
+                "Undeclared polymorphic serialization type error.");
+        }
+
+        // Fetch the serialization method.
+        auto serialization_method =
+            serialization_id_to_method_pair->second;
+
+        // Unlock the serialization method maps.
+        lock.unlock();
+
+        // Serialize (load) the given object.
+        serialization_method(archive, object);
+    }
+
+    /**
+     * Serialize a polymorphic type, in case of a saving (output) archive.
+     */
+    template <typename...,
+              typename ArchiveType = Archive,
+              typename = typename ArchiveType::saving>
+    void serialize(Archive & archive, const polymorphic & object)
+    {
+        // Lock the serialization method maps for read access.
+        std::shared_lock<shared_mutex> lock(m_shared_mutex);
+
+        // Find the serialization id.
+        auto type_information_to_serialization_id_pair =
+            m_type_information_to_serialization_id.find(
+                typeid(object).name());
+        if (m_type_information_to_serialization_id.end() ==
+            type_information_to_serialization_id_pair) {
+            throw undeclared_polymorphic_type_error(
+                "Undeclared polymorphic serialization type error.");
+        }
+
+        // Fetch the serialization id.
+        auto id = type_information_to_serialization_id_pair->second;
+
+        // Find the serialization method.
+        auto serialization_id_to_method_pair =
+            m_serialization_id_to_method.find(id);
+        if (m_serialization_id_to_method.end() ==
+            serialization_id_to_method_pair) {
+            throw undeclared_polymorphic_type_error(
+                "Undeclared polymorphic serialization type error.");
+        }
+
+        // Fetch the serialization method.
+        auto serialization_method =
+            serialization_id_to_method_pair->second;
+
+        // Unlock the serialization method maps.
+        lock.unlock();
+
+        // Serialize (save) the serialization id.
+        archive(id);
+
+        // Serialize (save) the given object.
+        serialization_method(archive, object);
+    }
+
+private:
+    /**
+     * Default constructor, defaulted.
+     */
+    registry() = default;
+
+private:
+    /**
+     * The shared mutex that protects the maps below.
+     */
+    shared_mutex m_shared_mutex;
+
+    /**
+     * A map between serialization id to method.
+     */
+    std::unordered_map<id_type, serialization_method_t<Archive>>
+        m_serialization_id_to_method;
+
+    /**
+     * A map between type information string to serialization id.
+     */
+    std::unordered_map<std::string, id_type>
+        m_type_information_to_serialization_id;
+};     // registry
+
+/**
+ * A dictionary of strings, that allows serializing repeated strings once.
+ * When used by an archive, the first occurrence of a string is serialized
+ * in full, and later occurrences as its index in the dictionary.
+ * Loaded strings are kept in the dictionary as shared strings, so that
+ * they may be loaded as std::shared_ptr<const std::string> without
+ * further allocations.
+ * Both ends must use a dictionary with the same history, for example,
+ * a new or cleared dictionary per stream of messages. If serialization
+ * fails, the dictionary should be cleared along with the stream.
+ */
+class string_dictionary
+{
+public:
+    /**
+     * Finds the index of the given string, adding the string if it is
+     * not found. Returns the index and whether the string was added.
+     */
+    std::pair<std::size_t, bool> insert(const std::string & string)
+    {
+        auto result = m_indices.emplace(string, m_indices.size());
+        return {result.first->second, result.second};
+    }
+
+    /**
+     * Adds a loaded string to the dictionary.
+     */
+    void add(std::shared_ptr<const std::string> string)
+    {
+        m_strings.push_back(std::move(string));
+    }
+
+    /**
+     * Returns the loaded string at the given index.
+     */
+    const std::shared_ptr<const std::string> & at(std::size_t index) const
+    {
+        if (index >= m_strings.size()) {
+            throw out_of_range("String dictionary index out of range.");
+        }
+        return m_strings[index];
+    }
+
+    /**
+     * Removes all the strings from the dictionary.
+     */
+    void clear() noexcept
+    {
+        m_indices.clear();
+        m_strings.clear();
+    }
+
+private:
+    /**
+     * A map between saved strings to their index.
+     */
+    std::unordered_map<std::string, std::size_t> m_indices;
+
+    /**
+     * The loaded strings, by index.
+     */
+    std::vector<std::shared_ptr<const std::string>> m_strings;
+}; // string_dictionary
+
+namespace detail
+{
+/**
+ * Returns a unique key for the given type, without requiring run time
+ * type information.
+ */
+template <typename Type>
+const void * type_key() noexcept
+{
+    static const char key{};
+    return std::addressof(key);
+}
+
+/**
+ * An open addressing hash map, with linear probing, between addresses
+ * of saved objects and their tracking information.
+ */
+class object_address_map
+{
+public:
+    /**
+     * The map entry, an empty entry has a null address.
+     */
+    struct entry
+    {
+        const void * address;
+        const void * type;
+        std::size_t id;
+    };
+
+    /**
+     * Finds the entry of the given address, or inserts a new entry if not
+     * found. Returns the entry and whether it was inserted.
+     */
+    std::pair<entry *, bool>
+    emplace(const void * address, const void * type, std::size_t id)
+    {
+        // Grow to keep the load factor at most one half.
+        if ((m_size + 1) * 2 > m_entries.size()) {
+            grow();
+        }
+
+        // Probe for the address or an empty entry.
+        auto mask = m_entries.size() - 1;
+        for (auto index = hash(address) & mask;;
+             index = (index + 1) & mask) {
+            auto & entry = m_entries[index];
+            if (entry.address == address) {
+                return {std::addressof(entry), false};
+            }
+            if (!entry.address) {
+                entry = {address, type, id};
+                ++m_size;
+                return {std::addressof(entry), true};
+            }
+        }
+    }
+
+    /**
+     * Removes all entries, keeping the capacity.
+     */
+    void clear() noexcept
+    {
+        std::fill(m_entries.begin(), m_entries.end(), entry{});
+        m_size = {};
+    }
+
+private:
+    /**
+     * Hashes the given address.
+     */
+    static std::size_t hash(const void * address) noexcept
+    {
+        auto value =
+            std::uint64_t(reinterpret_cast<std::uintptr_t>(address)) *
+            0x9e3779b97f4a7c15u;
+        return static_cast<std::size_t>(value ^ (value >> 32));
+    }
+
+    /**
+     * Doubles the capacity, and inserts the existing entries again.
+     */
+    void grow()
+    {
+        std::vector<entry> entries(
+            std::max<std::size_t>(m_entries.size() * 2, 16));
+        std::swap(entries, m_entries);
+        m_size = {};
+        for (auto & entry : entries) {
+            if (entry.address) {
+                emplace(entry.address, entry.type, entry.id);
+            }
+        }
+    }
+
+    /**
+     * The entries, the size is a power of two.
+     */
+    std::vector<entry> m_entries;
+
+    /**
+     * The number of non empty entries.
+     */
+    std::size_t m_size{};
+}; // object_address_map
+} // namespace detail
+
+/**
+ * Tracks the identity of shared objects, that allows serializing shared
+ * objects once.
+ * When used by an archive, every std::shared_ptr is serialized with a
+ * leading reference, zero for the first occurrence of the object, that is
+ * then serialized in full, and the object id plus one for later
+ * occurrences. Loading restores the same sharing of objects.
+ * Both ends must use a tracker with the same history, for example,
+ * a new or cleared tracker per stream of messages. Saved objects must
+ * not be destroyed while the tracker is in use, since they are
+ * identified by their address.
+ */
+class object_tracker
+{
+public:
+    /**
+     * Tracks an object that is about to be saved. Returns zero if the
+     * object is saved for the first time, else the object id plus one.
+     */
+    std::size_t save(const void * address, const void * type)
+    {
+        auto result = m_addresses.emplace(address, type, m_saved);
+        if (!result.second && result.first->type == type) {
+            return result.first->id + 1;
+        }
+
+        // A new object, with the next id.
+        ++m_saved;
+        return 0;
+    }
+
+    /**
+     * Adds a loaded object of the given type key, returns the object id.
+     */
+    std::size_t add(std::shared_ptr<void> object, const void * type)
+    {
+        m_objects.push_back({std::move(object), type});
+        return m_objects.size() - 1;
+    }
+
+    /**
+     * Sets the loaded object of the given id.
+     */
+    void set(std::size_t id, std::shared_ptr<void> object) noexcept
+    {
+        m_objects[id].object = std::move(object);
+    }
+
+    /**
+     * Returns the loaded object of the given id, that must be of the
+     * given type key.
+     */
+    const std::shared_ptr<void> & at(std::size_t id,
+                                     const void * type) const
+    {
+        if (id >= m_objects.size() || !m_objects[id].object) {
+            throw out_of_range("Object tracker id out of range.");
+        }
+        if (m_objects[id].type != type) {
+            throw tracked_type_mismatch_error(
+                "Tracked object type mismatch.");
+        }
+        return m_objects[id].object;
+    }
+
+    /**
+     * Removes all the tracked objects.
+     */
+    void clear() noexcept
+    {
+        m_addresses.clear();
+        m_saved = {};
+        m_objects.clear();
+    }
+
+private:
+    /**
+     * A loaded object and its type key.
+     */
+    struct loaded_object
+    {
+        std::shared_ptr<void> object;
+        const void * type;
+    };
+
+    /**
+     * A map between saved object addresses to their id.
+     */
+    detail::object_address_map m_addresses;
+
+    /**
+     * The number of saved objects.
+     */
+    std::size_t m_saved{};
+
+    /**
+     * The loaded objects, by id.
+     */
+    std::vector<loaded_object> m_objects;
+}; // object_tracker
+
+namespace detail
+{
+/**
+ * Returns the string dictionary of the archive, or null if none.
+ * This overload is for archives that support string dictionaries.
+ */
+template <typename Archive>
+auto dictionary_of(Archive & archive, int) noexcept
+    -> decltype(archive.dictionary())
+{
+    return archive.dictionary();
+}
+
+/**
+ * Returns the string dictionary of the archive, or null if none.
+ * This overload is for archives that do not support string
+ * dictionaries.
+ */
+template <typename Archive>
+string_dictionary * dictionary_of(Archive &, ...) noexcept
+{
+    return nullptr;
+}
+
+/**
+ * Returns the object tracker of the archive, or null if none.
+ * This overload is for archives that support object trackers.
+ */
+template <typename Archive>
+auto tracker_of(Archive & archive, int) noexcept
+    -> decltype(archive.tracker())
+{
+    return archive.tracker();
+}
+
+/**
+ * Returns the object tracker of the archive, or null if none.
+ * This overload is for archives that do not support object trackers.
+ */
+template <typename Archive>
+object_tracker * tracker_of(Archive &, ...) noexcept
+{
+    return nullptr;
+}
+} // namespace detail
+
+/**
+ * The alignment of flat objects, every field of a flat object is aligned
+ * to its natural alignment, which must not exceed this alignment.
+ */
+constexpr std::size_t flat_alignment = alignof(std::max_align_t);
+
+/**
+ * Describes a single field of a flat object.
+ */
+struct flat_field
+{
+    /**
+     * The offset of the field from the beginning of the object.
+     */
+    std::size_t offset{};
+
+    /**
+     * The size of the field in place.
+     */
+    std::size_t size{};
+
+    /**
+     * The type of the field, or of a single element if a span.
+     */
+    const void * type{};
+
+    /**
+     * Whether the field is a span of elements stored out of line.
+     */
+    bool span{};
+};
+
+namespace detail
+{
+/**
+ * Checks if the type may be stored in place in a flat object, that is,
+ * a fundamental, an enumeration, or a fixed array of those.
+ */
+template <typename Item>
+struct is_flat_value
+    : std::integral_constant<bool,
+                             std::is_fundamental<Item>::value ||
+                                 std::is_enum<Item>::value>
+{
+};
+
+/**
+ * Checks if the type may be stored in place in a flat object.
+ * This overload is for arrays.
+ */
+template <typename Item, std::size_t Size>
+struct is_flat_value<Item[Size]> : is_flat_value<Item>
+{
+};
+
+/**
+ * Checks if the type may be stored in place in a flat object.
+ * This overload is for std::array.
+ */
+template <typename Item, std::size_t Size>
+struct is_flat_value<std::array<Item, Size>> : is_flat_value<Item>
+{
+};
+
+/**
+ * Checks if the type is stored out of line as a span of a flat object,
+ * that is, a vector or string of flat values.
+ */
+template <typename Item>
+struct is_flat_span : std::false_type
+{
+};
+
+/**
+ * Checks if the type is stored out of line as a span of a flat object.
+ * This overload is for std::vector.
+ */
+template <typename Item, typename Allocator>
+struct is_flat_span<std::vector<Item, Allocator>>
+    : std::integral_constant<bool,
+                             is_flat_value<Item>::value &&
+                                 !std::is_same<Item, bool>::value>
+{
+};
+
+/**
+ * Checks if the type is stored out of line as a span of a flat object.
+ * This overload is for std::basic_string.
+ */
+template <typename Item, typename Traits, typename Allocator>
+struct is_flat_span<std::basic_string<Item, Traits, Allocator>>
+    : is_flat_value<Item>
+{
+};
+
+/**
+ * Returns the offset aligned up to the given alignment.
+ */
+inline std::size_t align_up(std::size_t offset,
+                            std::size_t alignment) noexcept
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+} // namespace detail
+
+/**
+ * This archive saves objects made only of fundamentals, enumerations,
+ * fixed arrays, and vectors or strings of those, in a flat layout that
+ * can be accessed in place using flat_view, with no load step.
+ * Every field is stored in place at its natural alignment, in the order
+ * it is serialized, classes with a serialize method being flattened.
+ * Vectors and strings are stored in place as a pair of size_type, the
+ * offset of the elements relative to the pair and the element count,
+ * with the elements stored aligned after the object.
+ * Every save operation appends an object into the vector, beginning at
+ * an offset aligned to flat_alignment.
+ */
+class flat_output_archive
+{
+public:
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Constructs a flat output archive, that outputs to the given vector.
+     */
+    explicit flat_output_archive(std::vector<unsigned char> & output) :
+        m_output(std::addressof(output))
+    {
+    }
+
+    /**
+     * Constructs a flat output archive, that outputs to the given vector,
+     * and records the fields of the saved objects into the given layout.
+     */
+    flat_output_archive(std::vector<unsigned char> & output,
+                        std::vector<flat_field> & layout) :
+        m_output(std::addressof(output)),
+        m_layout(std::addressof(layout))
+    {
+    }
+
+    /**
+     * Save the given items into the archive, as a single flat object.
+     */
+    template <typename... Items>
+    void operator()(const Items &... items)
+    {
+        // Disallow serialization of pointer types.
+        static_assert(
+            detail::all_of<!std::is_pointer<Items>::value...>::value,
+            "Serialization of pointer types is not allowed");
+
+        // Nested items are part of the current object.
+        if (m_depth) {
+            save_items(items...);
+            return;
+        }
+
+        // Begin a new object, aligned.
+        auto size = m_output->size();
+        try {
+            m_output->resize(detail::align_up(size, flat_alignment));
+            m_object = m_output->size();
+            m_spans.clear();
+
+            // Save the items in place.
+            ++m_depth;
+            save_items(items...);
+            --m_depth;
+
+            // Save the spans after the object.
+            for (auto & span : m_spans) {
+                auto position =
+                    detail::align_up(m_output->size(), span.alignment);
+                if (position - span.slot >
+                    std::numeric_limits<size_type>::max()) {
+                    throw out_of_range(
+                        "Flat object is too large for relative offsets.");
+                }
+                m_output->resize(position);
+                m_output->insert(m_output->end(),
+                                 span.data,
+                                 span.data + span.size);
+                store(span.slot, static_cast<size_type>(position - span.slot));
+            }
+        } catch (...) {
+            // Remove the partially saved object.
+            m_depth = {};
+            m_output->resize(size);
+            throw;
+        }
+    }
+
+private:
+    /**
+     * A span that is saved after the object.
+     */
+    struct pending_span
+    {
+        /**
+         * The elements data.
+         */
+        const unsigned char * data{};
+
+        /**
+         * The size of the elements data in bytes.
+         */
+        std::size_t size{};
+
+        /**
+         * The alignment of the elements.
+         */
+        std::size_t alignment{};
+
+        /**
+         * The position of the offset and count pair in the output.
+         */
+        std::size_t slot{};
+    };
+
+    /**
+     * Save the given items one by one.
+     */
+    template <typename... Items>
+    void save_items(const Items &... items)
+    {
+        std::initializer_list<int>{(save_item(items), 0)...};
+    }
+
+    /**
+     * Save a single item.
+     * This overload is for values that are stored in place.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<detail::is_flat_value<Item>::value>>
+    void save_item(const Item & item)
+    {
+        static_assert(alignof(Item) <= flat_alignment,
+                      "Alignment exceeds the flat alignment.");
+
+        auto position = append(
+            sizeof(item), alignof(Item), false, detail::type_key<Item>());
+        std::memcpy(m_output->data() + position,
+                    std::addressof(item),
+                    sizeof(item));
+    }
+
+    /**
+     * Save a single item.
+     * This overload is for vectors and strings that are stored out of
+     * line.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<detail::is_flat_span<Item>::value>,
+              typename = void>
+    void save_item(const Item & item)
+    {
+        using value_type = typename Item::value_type;
+        static_assert(alignof(value_type) <= flat_alignment,
+                      "Alignment exceeds the flat alignment.");
+
+        if (item.size() > std::numeric_limits<size_type>::max()) {
+            throw out_of_range("Flat span size is too large.");
+        }
+
+        // Store an empty offset and the count, the offset is stored
+        // once the elements are saved.
+        auto position = append(sizeof(size_type) * 2,
+                               alignof(size_type),
+                               true,
+                               detail::type_key<value_type>());
+        store(position, size_type{});
+        store(position + sizeof(size_type),
+              static_cast<size_type>(item.size()));
+
+        if (!item.empty()) {
+            m_spans.push_back(
+                {reinterpret_cast<const unsigned char *>(item.data()),
+                 item.size() * sizeof(value_type),
+                 alignof(value_type),
+                 position});
+        }
+    }
+
+    /**
+     * Save a single item.
+     * This overload is for class types with serialize method, whose
+     * fields are stored in place of the class.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<!detail::is_flat_value<Item>::value &&
+                                          !detail::is_flat_span<Item>::value>,
+              typename = decltype(Item::serialize(
+                  std::declval<flat_output_archive &>(),
+                  std::declval<const Item &>())),
+              typename = void,
+              typename = void>
+    void save_item(const Item & item)
+    {
+        Item::serialize(*this, item);
+    }
+
+    /**
+     * Appends a field to the object, and returns its position in the
+     * output, recording the field into the layout if requested.
+     */
+    std::size_t append(std::size_t size,
+                       std::size_t alignment,
+                       bool span,
+                       const void * type)
+    {
+        auto position = detail::align_up(m_output->size(), alignment);
+        m_output->resize(position + size);
+        if (m_layout) {
+            m_layout->push_back({position - m_object,
+                                 span ? sizeof(size_type) * 2 : size,
+                                 type,
+                                 span});
+        }
+        return position;
+    }
+
+    /**
+     * Stores the given size at the given position in the output.
+     */
+    void store(std::size_t position, size_type value) noexcept
+    {
+        std::memcpy(m_output->data() + position, &value, sizeof(value));
+    }
+
+    /**
+     * The output vector.
+     */
+    std::vector<unsigned char> * m_output{};
+
+    /**
+     * The layout to record the fields into, may be null.
+     */
+    std::vector<flat_field> * m_layout{};
+
+    /**
+     * The spans to save after the current object.
+     */
+    std::vector<pending_span> m_spans;
+
+    /**
+     * The position of the current object in the output.
+     */
+    std::size_t m_object{};
+
+    /**
+     * The nesting depth of the current save operation.
+     */
+    std::size_t m_depth{};
+}; // flat_output_archive
+
+/**
+ * A read only span of elements of a flat object.
+ */
+template <typename Element>
+class flat_span
+{
+public:
+    /**
+     * Constructs the span from pointer and count of elements.
+     */
+    flat_span(const Element * data, std::size_t size) noexcept :
+        m_data(data),
+        m_size(size)
+    {
+    }
+
+    /**
+     * Returns a pointer to the first element.
+     */
+    const Element * data() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * Returns the number of elements.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns true if there are no elements, else false.
+     */
+    bool empty() const noexcept
+    {
+        return !m_size;
+    }
+
+    /**
+     * Returns the element at the given index.
+     */
+    const Element & operator[](std::size_t index) const noexcept
+    {
+        return m_data[index];
+    }
+
+    /**
+     * Returns an iterator to the first element.
+     */
+    const Element * begin() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * Returns an iterator past the last element.
+     */
+    const Element * end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+private:
+    /**
+     * Pointer to the elements.
+     */
+    const Element * m_data{};
+
+    /**
+     * The number of elements.
+     */
+    std::size_t m_size{};
+};
+
+/**
+ * Accesses the fields of a flat object saved by flat_output_archive in
+ * place, with no load step. Fields are numbered in the order they are
+ * serialized, depth first, so that nested classes are flattened.
+ * The data must be aligned to flat_alignment, and outlive the view.
+ * Example:
+ * ~~~
+ * zpp::serializer::flat_view<point> view(data.data(), data.size());
+ * auto x = view.field<int>(0);
+ * auto name = view.span<char>(2);
+ * ~~~
+ */
+template <typename Type>
+class flat_view
+{
+public:
+    /**
+     * Constructs a view of the flat object at the given data.
+     */
+    flat_view(const unsigned char * data, std::size_t size) :
+        m_data(data),
+        m_size(size)
+    {
+        if (reinterpret_cast<std::uintptr_t>(data) % flat_alignment) {
+            throw out_of_range("Flat object data is not aligned.");
+        }
+
+        auto & fields = layout();
+        if (!fields.empty() &&
+            fields.back().offset + fields.back().size > size) {
+            throw out_of_range("Flat object data is too small.");
+        }
+    }
+
+    /**
+     * Returns the number of fields.
+     */
+    static std::size_t fields()
+    {
+        return layout().size();
+    }
+
+    /**
+     * Returns a reference to the field at the given index, which is
+     * stored in place.
+     */
+    template <typename Item>
+    const Item & field(std::size_t index) const
+    {
+        auto & entry = checked_field<Item>(index, false);
+        return *reinterpret_cast<const Item *>(m_data + entry.offset);
+    }
+
+    /**
+     * Returns the elements of the field at the given index, which is a
+     * vector or string.
+     */
+    template <typename Element>
+    flat_span<Element> span(std::size_t index) const
+    {
+        auto & entry = checked_field<Element>(index, true);
+
+        size_type offset{};
+        size_type count{};
+        std::memcpy(&offset, m_data + entry.offset, sizeof(offset));
+        std::memcpy(&count,
+                    m_data + entry.offset + sizeof(offset),
+                    sizeof(count));
+
+        if (!count) {
+            return {nullptr, 0};
+        }
+
+        // Verify the elements are within the data and aligned.
+        auto position = entry.offset + offset;
+        if (position % alignof(Element) ||
+            count > (m_size - std::min(m_size, position)) / sizeof(Element)) {
+            throw out_of_range("Flat span is out of range.");
+        }
+
+        return {reinterpret_cast<const Element *>(m_data + position), count};
+    }
+
+    /**
+     * Returns the layout of the type, which is recorded once by saving
+     * a default constructed object.
+     */
+    static const std::vector<flat_field> & layout()
+    {
+        static const auto fields = [] {
+            std::vector<unsigned char> data;
+            std::vector<flat_field> fields;
+            flat_output_archive archive(data, fields);
+            archive(*access::make_unique<Type>());
+            return fields;
+        }();
+        return fields;
+    }
+
+private:
+    /**
+     * Returns the field at the given index, verifying that it matches
+     * the requested type and kind.
+     */
+    template <typename Item>
+    const flat_field & checked_field(std::size_t index, bool span) const
+    {
+        auto & fields = layout();
+        if (index >= fields.size()) {
+            throw out_of_range("Flat field index is out of range.");
+        }
+
+        auto & entry = fields[index];
+        if (entry.span != span ||
+            entry.type != detail::type_key<std::remove_const_t<Item>>()) {
+            throw out_of_range("Flat field type does not match.");
+        }
+        return entry;
+    }
+
+    /**
+     * The flat object data.
+     */
+    const unsigned char * m_data{};
+
+    /**
+     * The flat object data size.
+     */
+    std::size_t m_size{};
+};
+
+template <typename SizeType, typename Container>
+class sized_container;
+
+template <typename Container>
+class parallel_output_container;
+
+namespace detail
+{
+/**
+ * Clears the given item before it is loaded from a patch.
+ * This overload is for items with clear method, such as containers.
+ */
+template <typename Item>
+auto clear_patched(Item & item, int) -> decltype(item.clear())
+{
+    item.clear();
+}
+
+/**
+ * Clears the given item before it is loaded from a patch.
+ * This overload is for items without clear method, that are overwritten.
+ */
+template <typename Item>
+void clear_patched(Item &, ...)
+{
+}
+
+/**
+ * Clears the given item before it is loaded from a patch.
+ * This overload is for containers with specific size type, whose
+ * wrapped container is cleared, as it is loaded as usual.
+ */
+template <typename SizeType, typename Container>
+void clear_patched(sized_container<SizeType, Container> & item, int)
+{
+    clear_patched(item.container, 0);
+}
+
+/**
+ * Clears the given item before it is loaded from a patch.
+ * This overload is for containers saved in parallel, whose wrapped
+ * container is cleared, as it is loaded as usual.
+ */
+template <typename Container>
+void clear_patched(parallel_output_container<Container> & item, int)
+{
+    clear_patched(item.container, 0);
+}
+
+/**
+ * Checks if the item is walked into by patch archives, rather than
+ * patched as a whole. These are class type lvalues with serialize
+ * method, while wrapper temporaries, containers and other items are
+ * patched as a whole.
+ */
+template <typename Archive, typename Item, typename = void>
+struct is_patch_composite : std::false_type
+{
+};
+
+/**
+ * Checks if the item is walked into by patch archives.
+ * This overload is for class type lvalues with serialize method.
+ */
+template <typename Archive, typename Item>
+struct is_patch_composite<
+    Archive,
+    Item,
+    void_t<decltype(std::remove_reference_t<Item>::serialize(
+        std::declval<Archive &>(),
+        std::declval<std::remove_reference_t<Item> &>()))>>
+    : std::is_lvalue_reference<Item>
+{
+};
+
+/**
+ * Records the serialized form of every leaf of an object, that is,
+ * every item that is patched as a whole, numbered depth first.
+ */
+class patch_recorder
+{
+public:
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Records the given items.
+     */
+    template <typename... Items>
+    void operator()(Items &&... items)
+    {
+        std::initializer_list<int>{
+            (record(std::forward<Items>(items)), 0)...};
+    }
+
+    /**
+     * Clears the recorded leaves.
+     */
+    void clear() noexcept
+    {
+        m_data.clear();
+        m_ends.clear();
+    }
+
+    /**
+     * Returns the number of recorded leaves.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_ends.size();
+    }
+
+    /**
+     * Returns the serialized data of the leaf at the given index.
+     */
+    const unsigned char * data(std::size_t index) const noexcept
+    {
+        return m_data.data() + (index ? m_ends[index - 1] : 0);
+    }
+
+    /**
+     * Returns the serialized size of the leaf at the given index.
+     */
+    std::size_t size(std::size_t index) const noexcept
+    {
+        return m_ends[index] - (index ? m_ends[index - 1] : 0);
+    }
+
+private:
+    /**
+     * Records a single item.
+     * This overload is for class types with serialize method, that are
+     * walked into.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<
+                  is_patch_composite<patch_recorder, Item>::value>>
+    void record(Item && item)
+    {
+        std::remove_reference_t<Item>::serialize(*this, item);
+    }
+
+    /**
+     * Records a single item.
+     * This overload is for fundamental types and enumerations, that are
+     * copied as is.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<
+                  std::is_fundamental<std::remove_reference_t<Item>>::value ||
+                  std::is_enum<std::remove_reference_t<Item>>::value>,
+              typename = void>
+    void record(Item && item)
+    {
+        auto data = reinterpret_cast<const unsigned char *>(
+            std::addressof(item));
+        m_data.insert(m_data.end(), data, data + sizeof(item));
+        m_ends.push_back(m_data.size());
+    }
+
+    /**
+     * Records a single item.
+     * This overload is for any other item, that is saved as a whole.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<
+                  !is_patch_composite<patch_recorder, Item>::value &&
+                  !std::is_fundamental<std::remove_reference_t<Item>>::value &&
+                  !std::is_enum<std::remove_reference_t<Item>>::value>,
+              typename = void,
+              typename = void>
+    void record(Item && item)
+    {
+        memory_output_archive archive(m_data);
+        archive(std::forward<Item>(item));
+        m_ends.push_back(m_data.size());
+    }
+
+    /**
+     * The serialized data of the leaves.
+     */
+    std::vector<unsigned char> m_data;
+
+    /**
+     * The end offset of every leaf in the data.
+     */
+    std::vector<std::size_t> m_ends;
+};
+} // namespace detail
+
+/**
+ * This archive saves patches, that update an object from a previous
+ * version to the current version, to be applied by patch_input_archive.
+ * Both versions are walked through their serialize method, and only the
+ * leaves that changed are saved, with their index. Leaves are the items
+ * that are not class types with serialize method, such as fundamentals
+ * and containers, which are compared and saved as a whole.
+ * The serialize method must serialize the same items regardless of the
+ * object state and of whether saving or loading.
+ * Every save operation appends a patch into the vector.
+ * Example:
+ * ~~~
+ * zpp::serializer::patch_output_archive out(patch);
+ * out(previous_state, current_state);
+ * ~~~
+ */
+class patch_output_archive
+{
+public:
+    /**
+     * Constructs a patch output archive, that outputs to the given
+     * vector.
+     */
+    explicit patch_output_archive(std::vector<unsigned char> & output) :
+        m_output(std::addressof(output))
+    {
+    }
+
+    /**
+     * Saves a patch from the previous version to the current version of
+     * an object.
+     */
+    template <typename Item>
+    void operator()(const Item & previous, const Item & current)
+    {
+        // Record the leaves of both versions.
+        m_previous.clear();
+        m_current.clear();
+        m_previous(previous);
+        m_current(current);
+        if (m_previous.size() != m_current.size()) {
+            throw patch_structure_mismatch_error(
+                "Versions serialize a different number of items.");
+        }
+
+        // Collect the changed leaves.
+        m_changed.clear();
+        for (std::size_t i{}; i < m_current.size(); ++i) {
+            if (m_previous.size(i) != m_current.size(i) ||
+                !std::equal(m_current.data(i),
+                            m_current.data(i) + m_current.size(i),
+                            m_previous.data(i))) {
+                m_changed.push_back(i);
+            }
+        }
+
+        // Save the number of changed leaves, followed by the index and
+        // data of every changed leaf.
+        auto size = m_output->size();
+        try {
+            memory_output_archive archive(*m_output);
+            archive(static_cast<size_type>(m_changed.size()));
+            for (auto index : m_changed) {
+                archive(static_cast<size_type>(index),
+                        as_bytes(m_current.data(index),
+                                 m_current.size(index)));
+            }
+        } catch (...) {
+            m_output->resize(size);
+            throw;
+        }
+    }
+
+private:
+    /**
+     * The output vector.
+     */
+    std::vector<unsigned char> * m_output{};
+
+    /**
+     * The leaves of the previous version.
+     */
+    detail::patch_recorder m_previous;
+
+    /**
+     * The leaves of the current version.
+     */
+    detail::patch_recorder m_current;
+
+    /**
+     * The indices of the changed leaves.
+     */
+    std::vector<std::size_t> m_changed;
+}; // patch_output_archive
+
+/**
+ * This archive applies patches saved by patch_output_archive, updating
+ * an existing object in place. The object is walked through its
+ * serialize method, and only the changed leaves are loaded, containers
+ * being cleared first, also when wrapped by size_is or parallel_output.
+ * Every load operation applies a patch and erases it from the beginning
+ * of the vector.
+ * Example:
+ * ~~~
+ * zpp::serializer::patch_input_archive in(patch);
+ * in(state);
+ * ~~~
+ */
+class patch_input_archive
+{
+public:
+    /**
+     * Loading archive.
+     */
+    using loading = void;
+
+    /**
+     * Constructs a patch input archive from a vector.
+     */
+    explicit patch_input_archive(std::vector<unsigned char> & input) :
+        m_input(input.data(), input.size()),
+        m_input_vector(std::addressof(input))
+    {
+    }
+
+    /**
+     * Applies a patch to the given items, or walks through the given
+     * items if nested.
+     */
+    template <typename... Items>
+    void operator()(Items &&... items)
+    {
+        // Nested items are part of the current patch.
+        if (m_depth) {
+            std::initializer_list<int>{
+                (apply(std::forward<Items>(items)), 0)...};
+            return;
+        }
+
+        // Fetch the number of changed leaves and the first index.
+        m_input = memory_view_input_archive(m_input_vector->data(),
+                                            m_input_vector->size());
+        m_input(m_remaining);
+        m_leaf = {};
+        fetch_index();
+
+        // Apply the patch.
+        ++m_depth;
+        try {
+            std::initializer_list<int>{
+                (apply(std::forward<Items>(items)), 0)...};
+        } catch (...) {
+            m_depth = {};
+            throw;
+        }
+        m_depth = {};
+
+        // Every changed leaf must have been reached.
+        if (m_pending) {
+            throw out_of_range("Patch index is out of range.");
+        }
+
+        // Erase the applied patch.
+        m_input_vector->erase(m_input_vector->begin(),
+                              m_input_vector->begin() + m_input.offset());
+    }
+
+private:
+    /**
+     * Applies the patch to a single item.
+     * This overload is for class types with serialize method, that are
+     * walked into.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<
+                  detail::is_patch_composite<patch_input_archive,
+                                             Item>::value>>
+    void apply(Item && item)
+    {
+        std::remove_reference_t<Item>::serialize(*this, item);
+    }
+
+    /**
+     * Applies the patch to a single item.
+     * This overload is for leaves, that are loaded if changed.
+     */
+    template <typename Item,
+              typename...,
+              typename = std::enable_if_t<
+                  !detail::is_patch_composite<patch_input_archive,
+                                              Item>::value>,
+              typename = void>
+    void apply(Item && item)
+    {
+        if (m_pending && m_index == m_leaf) {
+            detail::clear_patched(item, 0);
+            m_input(std::forward<Item>(item));
+            fetch_index();
+        }
+        ++m_leaf;
+    }
+
+    /**
+     * Fetches the index of the next changed leaf, if any.
+     */
+    void fetch_index()
+    {
+        m_pending = m_remaining != 0;
+        if (!m_pending) {
+            return;
+        }
+
+        --m_remaining;
+        size_type index{};
+        m_input(index);
+        if (index < m_leaf) {
+            throw out_of_range("Patch indices are not increasing.");
+        }
+        m_index = index;
+    }
+
+    /**
+     * The input archive of the current patch.
+     */
+    memory_view_input_archive m_input;
+
+    /**
+     * The input vector.
+     */
+    std::vector<unsigned char> * m_input_vector{};
+
+    /**
+     * The number of changed leaves not yet fetched.
+     */
+    size_type m_remaining{};
+
+    /**
+     * The index of the next changed leaf.
+     */
+    std::size_t m_index{};
+
+    /**
+     * The index of the current leaf.
+     */
+    std::size_t m_leaf{};
+
+    /**
+     * Whether there is a changed leaf to apply.
+     */
+    bool m_pending{};
+
+    /**
+     * The nesting depth of the current load operation.
+     */
+    std::size_t m_depth{};
+}; // patch_input_archive
+#endif // ZPP_SERIALIZER_FREESTANDING
+
+namespace detail
+{
+/**
+ * Loads 'size' items into a random access container.
+ * The container is resized to match the size. If items may be
+ * serialized in no bytes, the size is not bounded by the input, so the
+ * container is resized to an initial size and grows as items are loaded
+ * instead.
+ */
+template <typename Archive, typename Container>
+auto load_items(Archive & archive,
+                Container & container,
+                std::size_t size,
+                std::size_t min_size,
+                std::random_access_iterator_tag)
+{
+    // Resize the container to match the size, or the initial size.
+    container.resize(
+        min_size
+            ? size
+            : std::min<std::size_t>(
+                  size,
+                  initial_load_size<typename Container::value_type>));
+
+    // Serialize all the items.
+    for (std::size_t loaded{}; loaded < size;) {
+        // Grow the container by doubling its size, unless the archive
+        // failed with a sticky error, which stops the growth.
+        if (loaded == container.size()) {
+            if (failed_of(archive, 0)) {
+                break;
+            }
+            container.resize(std::min<std::size_t>(size, loaded * 2));
+        }
+
+        for (auto item = container.begin() + loaded;
+             item != container.end();
+             ++item, ++loaded) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            archive(*item);
+#else
+            if (auto result = archive(*item); !result) {
+                return result;
+            }
+#endif
+        }
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Loads 'size' items into a node based sequence container, such as
+ * std::list, in a single pass. Existing items are loaded in place, new
+ * items are appended as needed, and extra items are erased.
+ */
+template <typename Archive, typename Container>
+auto load_items(Archive & archive,
+                Container & container,
+                std::size_t size,
+                std::size_t,
+                std::bidirectional_iterator_tag)
+{
+    auto item = container.begin();
+    for (std::size_t i{}; i < size; ++i, ++item) {
+        // Append an item if there are no more existing items, unless the
+        // archive failed with a sticky error.
+        if (item == container.end()) {
+            if (failed_of(archive, 0)) {
+                break;
+            }
+            container.emplace_back();
+            item = std::prev(container.end());
+        }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(*item);
+#else
+        if (auto result = archive(*item); !result) {
+            return result;
+        }
+#endif
+    }
+
+    // Erase the extra items.
+    container.erase(item, container.end());
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize resizable containers, operates on loading (input) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    resizable_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Deduce the container item type.
+    using item_type = typename Container::value_type;
+
+    // The minimum number of bytes an item is serialized in.
+    constexpr auto min_size = detail::min_serialized_size<item_type>::value;
+
+    // Verify the size against the remaining input and allocation budget.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(archive, size, min_size, sizeof(item_type));
+#else
+    if (auto result = detail::verify_load_size(
+            archive, size, min_size, sizeof(item_type));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Serialize all the items.
+    return detail::load_items(
+        archive,
+        container,
+        size,
+        min_size,
+        typename std::iterator_traits<
+            typename Container::iterator>::iterator_category{});
+}
+
+/**
+ * Serialize containers, operates on saving (output) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto save_container(Archive & archive,
+                    const Container & container,
+                    sequence_container_tag)
+{
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    // Save the container size.
+    archive(static_cast<SizeType>(container.size()));
+#else
+    if (auto result = archive(static_cast<SizeType>(container.size()));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Serialize all the items.
+    for (auto & item : container) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize view containers, operates on loading (input) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    view_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Check size.
+    if (size > container.size()) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw out_of_range("View type container out of range.");
+#else
+        return freestanding::error{error::out_of_range};
+#endif
+    }
+
+    // Resize the view container to match the size.
+    container = {container.data(), size};
+
+    // Serialize all the items.
+    for (auto & item : container) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+}
+
+/**
+ * Serialize resizable, continuous containers, of fundamental or
+ * enumeration types. Operates on loading (input) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    resizable_contiguous_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Verify the size against the remaining input and allocation budget.
+    using item_type = typename Container::value_type;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(
+        archive, size, sizeof(item_type), sizeof(item_type));
+#else
+    if (auto result = detail::verify_load_size(
+            archive, size, sizeof(item_type), sizeof(item_type));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Resize the container to match the size.
+    container.resize(size);
+
+    // If the size is zero, return.
+    if (!size) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        return;
+#else
+        return freestanding::error{error::success};
+#endif
+    }
+
+    // Serialize the bytes data.
+    return archive(as_bytes(std::addressof(container[0]),
+                            static_cast<SizeType>(container.size())));
+}
+
+/**
+ * Serialize continuous containers, of fundamental or
+ * enumeration types. Operates on saving (output) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto save_container(Archive & archive,
+                    const Container & container,
+                    contiguous_container_tag)
+{
+    // The container size.
+    auto size = static_cast<SizeType>(container.size());
+
+    // Save the container size.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // If the size is zero, return.
+    if (!size) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        return;
+#else
+        return freestanding::error{error::success};
+#endif
+    }
+
+    // Serialize the bytes data.
+    return archive(as_bytes(std::addressof(container[0]),
+                            static_cast<SizeType>(container.size())));
+}
+
+/**
+ * Serialize continuous view containers, of fundamental or
+ * enumeration types. Operates on loading (input) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    contiguous_view_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Check the size.
+    if (size > container.size()) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw out_of_range("View type container out of range.");
+#else
+        return freestanding::error{error::out_of_range};
+#endif
+    }
+
+    // Resize the view container to match the size.
+    container = {container.data(), size};
+
+    // If the size is zero, return.
+    if (!size) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        return;
+#else
+        return freestanding::error{error::success};
+#endif
+    }
+
+    // Serialize the bytes data.
+    return archive(as_bytes(std::addressof(container[0]),
+                            static_cast<SizeType>(container.size())));
+}
+
+/**
+ * Serialize resizable, segmented containers, of fundamental or
+ * enumeration types, such as std::deque. Operates on loading (input)
+ * archives. Every contiguous segment is loaded as bytes data.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    segmented_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Verify the size against the remaining input and allocation budget.
+    using item_type = typename Container::value_type;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(
+        archive, size, sizeof(item_type), sizeof(item_type));
+#else
+    if (auto result = detail::verify_load_size(
+            archive, size, sizeof(item_type), sizeof(item_type));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Resize the container to match the size.
+    container.resize(size);
+
+    // Serialize the bytes data of every segment.
+    for (std::size_t offset{}; offset < size;) {
+        auto item = container.begin() + offset;
+        auto run = detail::contiguous_run(item, size - offset);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(std::addressof(*item), run));
+#else
+        if (auto result = archive(as_bytes(std::addressof(*item), run));
+            !result) {
+            return result;
+        }
+#endif
+        offset += run;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize segmented containers, of fundamental or enumeration types,
+ * such as std::deque. Operates on saving (output) archives.
+ * Every contiguous segment is saved as bytes data.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto save_container(Archive & archive,
+                    const Container & container,
+                    segmented_container_tag)
+{
+    // The container size.
+    auto size = static_cast<SizeType>(container.size());
+
+    // Save the container size.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Serialize the bytes data of every segment.
+    for (std::size_t offset{}; offset < size;) {
+        auto item = container.begin() + offset;
+        auto run = detail::contiguous_run(item, size - offset);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(std::addressof(*item), run));
+#else
+        if (auto result = archive(as_bytes(std::addressof(*item), run));
+            !result) {
+            return result;
+        }
+#endif
+        offset += run;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize singly linked containers, such as std::forward_list,
+ * operates on loading (input) archives.
+ * Loads in a single pass, existing items are loaded in place, new items
+ * are appended as needed, and extra items are erased.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    singly_linked_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Verify the size against the remaining input and allocation budget.
+    using item_type = typename Container::value_type;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(archive,
+                             size,
+                             detail::min_serialized_size<item_type>::value,
+                             sizeof(item_type));
+#else
+    if (auto result = detail::verify_load_size(
+            archive,
+            size,
+            detail::min_serialized_size<item_type>::value,
+            sizeof(item_type));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Serialize all the items.
+    auto previous = container.before_begin();
+    for (SizeType i{}; i < size; ++i) {
+        // Append an item if there are no more existing items, unless the
+        // archive failed with a sticky error.
+        auto item = std::next(previous);
+        if (item == container.end()) {
+            if (detail::failed_of(archive, 0)) {
+                break;
+            }
+            item = container.emplace_after(previous);
+        }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(*item);
+#else
+        if (auto result = archive(*item); !result) {
+            return result;
+        }
+#endif
+        previous = item;
+    }
+
+    // Erase the extra items.
+    container.erase_after(previous, container.end());
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize singly linked containers, such as std::forward_list,
+ * operates on saving (output) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto save_container(Archive & archive,
+                    const Container & container,
+                    singly_linked_container_tag)
+{
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    // Save the container size.
+    archive(static_cast<SizeType>(
+        std::distance(container.begin(), container.end())));
+#else
+    if (auto result = archive(static_cast<SizeType>(
+            std::distance(container.begin(), container.end())));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Serialize all the items.
+    for (auto & item : container) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize Associative and UnorderedAssociative containers, operates on
+ * loading (input) archives.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    associative_container_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Deduce the container item type.
+    using item_type = detail::container_nonconst_value_type_t<Container>;
+
+    // Verify the size against the remaining input and allocation budget.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(archive,
+                             size,
+                             detail::min_serialized_size<item_type>::value,
+                             sizeof(item_type));
+#else
+    if (auto result = detail::verify_load_size(
+            archive,
+            size,
+            detail::min_serialized_size<item_type>::value,
+            sizeof(item_type));
+        !result) {
+        return result;
+    }
+#endif
+
+    // Reserve room for the items, for unordered containers, to avoid
+    // rehashing during the load. The reserved size is bounded by the
+    // remaining input, in case items may be serialized in no bytes.
+    detail::reserve_if_reservable(
+        container,
+        container.size() +
+            std::min<std::size_t>(size, detail::remaining_of(archive, 0)),
+        0);
+
+    // Serialize all the items, until the archive fails with a sticky
+    // error, if any.
+    for (SizeType i{}; i < size && !detail::failed_of(archive, 0); ++i) {
+        // Create just enough storage properly aligned for one item.
+        std::aligned_storage_t<sizeof(item_type), alignof(item_type)>
+            storage;
+
+        // Create the object at the storage.
+        std::unique_ptr<item_type, void (*)(item_type *)> object(
+            access::placement_new<item_type>(std::addressof(storage)),
+            [](auto pointer) { access::destruct(*pointer); });
+
+        // Serialize the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(*object);
+#else
+        if (auto result = archive(*object); !result) {
+            return result;
+        }
+#endif
+
+        // Insert the item to the container, with the end as a hint, since
+        // ordered containers are saved in order, which makes insertion
+        // into ordered containers amortized constant.
+        container.insert(container.end(), std::move(*object));
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * Serialize std::string, operates on loading (input) archives.
+ * When the archive uses a string dictionary, the leading size holds
+ * either the size of a new string shifted left by one, or the index of
+ * a string in the dictionary shifted left by one, with the lowest bit set.
+ */
+template <typename SizeType, typename Archive, typename Container>
+void load_container(Archive & archive,
+                    Container & string,
+                    dictionary_string_tag)
+{
+    SizeType value{};
+
+    // Fetch the size or index.
+    archive(value);
+
+    // Fetch the string dictionary of the archive.
+    auto dictionary = detail::dictionary_of(archive, 0);
+
+    // The size of the string.
+    std::size_t size = value;
+
+    // If using a string dictionary, check for a string index.
+    if (dictionary) {
+        if (value & 1) {
+            string = *dictionary->at(value >> 1);
+            return;
+        }
+        size = value >> 1;
+    }
+
+    // Verify the size against the remaining input and allocation budget.
+    detail::verify_load_size(archive, size, 1, 1);
+
+    // Resize the string to match the size.
+    string.resize(size);
+
+    // Load the string characters.
+    if (size) {
+        archive(as_bytes(std::addressof(string[0]), size));
+    }
+
+    // Add the loaded string to the string dictionary.
+    if (dictionary) {
+        dictionary->add(std::make_shared<const std::string>(string));
+    }
+}
+
+/**
+ * Serialize std::string, operates on saving (output) archives.
+ * When the archive uses a string dictionary, the leading size holds
+ * either the size of a new string shifted left by one, or the index of
+ * a string in the dictionary shifted left by one, with the lowest bit set.
+ */
+template <typename SizeType, typename Archive, typename Container>
+void save_container(Archive & archive,
+                    const Container & string,
+                    dictionary_string_tag)
+{
+    // Fetch the string dictionary of the archive.
+    auto dictionary = detail::dictionary_of(archive, 0);
+
+    // If not using a string dictionary, save the size.
+    if (!dictionary) {
+        archive(static_cast<SizeType>(string.size()));
+    } else {
+        // The maximum size or index that fits in the size type.
+        constexpr std::size_t max_value = SizeType(~SizeType{}) >> 1;
+
+        // Check that the size fits before changing the dictionary.
+        if (string.size() > max_value) {
+            throw out_of_range("String too long for string dictionary.");
+        }
+
+        // Find the string, or add it.
+        auto entry = dictionary->insert(string);
+
+        // If found, save only the index, provided that it fits.
+        if (!entry.second && entry.first <= max_value) {
+            archive(static_cast<SizeType>((entry.first << 1) | 1));
+            return;
+        }
+
+        // Save the size.
+        archive(static_cast<SizeType>(string.size() << 1));
+    }
+
+    // Save the string characters.
+    if (!string.empty()) {
+        archive(as_bytes(string.data(), string.size()));
+    }
+}
+
+#endif
+
+/**
+ * Serialize std::vector<bool>, operates on loading (input) archives.
+ * The bits are packed eight per byte, least significant bit first.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto load_container(Archive & archive,
+                    Container & container,
+                    bool_vector_tag)
+{
+    SizeType size{};
+
+    // Fetch the number of bits to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Verify the size against the remaining input and allocation budget.
+    auto byte_count = (std::size_t(size) + 7) / 8;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    detail::verify_load_size(archive, byte_count, 1, 1);
+#else
+    if (auto result = detail::verify_load_size(archive, byte_count, 1, 1);
+        !result) {
+        return result;
+    }
+#endif
+
+    // Clear the size if the byte count was cleared.
+    if (!byte_count) {
+        size = 0;
+    }
+
+    // Resize the container to match the size.
+    container.resize(size);
+
+    // Load the packed bits, one buffer at a time.
+    for (std::size_t offset{}; offset < size;) {
+        unsigned char buffer[detail::bit_buffer_size];
+        auto count =
+            std::min<std::size_t>(size - offset, sizeof(buffer) * 8);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(buffer, (count + 7) / 8));
+#else
+        if (auto result = archive(as_bytes(buffer, (count + 7) / 8));
+            !result) {
+            return result;
+        }
+#endif
+        detail::unpack_bits(buffer, count, container, offset);
+        offset += count;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::vector<bool>, operates on saving (output) archives.
+ * The bits are packed eight per byte, least significant bit first.
+ */
+template <typename SizeType, typename Archive, typename Container>
+auto save_container(Archive & archive,
+                    const Container & container,
+                    bool_vector_tag)
+{
+    // The container size.
+    auto size = static_cast<SizeType>(container.size());
+
+    // Save the container size.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(size);
+#else
+    if (auto result = archive(size); !result) {
+        return result;
+    }
+#endif
+
+    // Save the packed bits, one buffer at a time.
+    for (std::size_t offset{}; offset < size;) {
+        unsigned char buffer[detail::bit_buffer_size];
+        auto count =
+            std::min<std::size_t>(size - offset, sizeof(buffer) * 8);
+        detail::pack_bits(container, offset, count, buffer);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(buffer, (count + 7) / 8));
+#else
+        if (auto result = archive(as_bytes(buffer, (count + 7) / 8));
+            !result) {
+            return result;
+        }
+#endif
+        offset += count;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * The serialized size of a type whose every object is serialized in the
+ * same number of bytes, or zero if not known to be fixed.
+ */
+template <typename Type, typename = void>
+struct fixed_serialized_size;
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * Skips the given number of items, in one step if they are of fixed
+ * serialized size, else one by one, by walking the skipped object of
+ * their type.
+ */
+template <typename Item>
+void skip_items(skipping_archive & archive, std::size_t count)
+{
+    // Items of fixed serialized size are skipped in one step.
+    constexpr auto fixed_size = fixed_serialized_size<Item>::value;
+    if (fixed_size) {
+        verify_load_size(archive, count, fixed_size, 0);
+        archive.advance(count * fixed_size);
+        return;
+    }
+
+    // Verify that the items fit in the remaining input.
+    verify_load_size(archive, count, min_serialized_size<Item>::value, 0);
+
+    // Skip the items.
+    auto & item = skipped_object<Item>();
+    for (std::size_t i{}; i < count && !archive.failed(); ++i) {
+        archive(item);
+    }
+}
+
+/**
+ * Skips the given number of items that are serialized as bytes data, in
+ * one step.
+ */
+template <typename Item>
+void skip_bytes_items(skipping_archive & archive, std::size_t count)
+{
+    verify_load_size(archive, count, sizeof(Item), 0);
+    archive.advance(count * sizeof(Item));
+}
+
+/**
+ * Skip resizable containers, operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    resizable_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip view containers, operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    view_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip singly linked containers, operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    singly_linked_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip Associative and UnorderedAssociative containers, operates on
+ * skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    associative_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_items<container_nonconst_value_type_t<Container>>(archive, size);
+}
+
+/**
+ * Skip resizable, continuous containers, of fundamental or enumeration
+ * types, in one step. Operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    resizable_contiguous_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_bytes_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip continuous view containers, of fundamental or enumeration types,
+ * in one step. Operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    contiguous_view_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_bytes_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip segmented containers, of fundamental or enumeration types, in one
+ * step. Operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    segmented_container_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_bytes_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip std::string, in one step, operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    dictionary_string_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_bytes_items<typename Container::value_type>(archive, size);
+}
+
+/**
+ * Skip std::vector<bool>, in one step, operates on skipping archives.
+ */
+template <typename SizeType, typename Container>
+void load_container(skipping_archive & archive,
+                    Container &,
+                    bool_vector_tag)
+{
+    SizeType size{};
+    archive(size);
+    skip_bytes_items<unsigned char>(archive, (std::size_t(size) + 7) / 8);
+}
+#endif
+
+} // namespace detail
+
+/**
+ * Serialize containers, operates on loading (input) archives.
+ * The container is classified once, by detail::container_category, and
+ * is loaded by the overload of its category.
+ */
+template <typename Archive,
+          typename Container,
+          typename SizeType = size_type,
+          typename...,
+          typename Category = detail::container_category_t<Container>,
+          typename = std::enable_if_t<!std::is_void<Category>::value>,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, Container & container)
+{
+    return detail::load_container<SizeType>(archive, container, Category{});
+}
+
+/**
+ * Serialize containers, operates on saving (output) archives.
+ * The container is classified once, by detail::container_category, and
+ * is saved by the overload of its category.
+ */
+template <typename Archive,
+          typename Container,
+          typename SizeType = size_type,
+          typename...,
+          typename Category = detail::container_category_t<Container>,
+          typename = std::enable_if_t<!std::is_void<Category>::value>,
+          typename = typename Archive::saving,
+          typename = void>
+auto serialize(Archive & archive, const Container & container)
+{
+    return detail::save_container<SizeType>(archive, container, Category{});
+}
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * Serialize std::shared_ptr of const std::string, in case of a loading
+ * (input) archive. When the archive uses a string dictionary, repeated
+ * strings share the same loaded string.
+ */
+template <typename Archive,
+          typename...,
+          typename = typename Archive::loading>
+void serialize(Archive & archive,
+               std::shared_ptr<const std::string> & string)
+{
+    // Fetch the object tracker of the archive.
+    auto tracker = detail::tracker_of(archive, 0);
+
+    // If tracking objects, check for an already loaded string.
+    std::size_t id{};
+    if (tracker) {
+        size_type reference{};
+        archive(reference);
+        if (reference) {
+            string = std::static_pointer_cast<const std::string>(
+                tracker->at(reference - 1, detail::type_key<std::string>()));
+            return;
+        }
+
+        // Reserve the id of the string, set once loaded.
+        id = tracker->add(nullptr, detail::type_key<std::string>());
+    }
+
+    size_type value{};
+
+    // Fetch the size or index.
+    archive(value);
+
+    // Fetch the string dictionary of the archive.
+    auto dictionary = detail::dictionary_of(archive, 0);
+
+    // If using a string dictionary, and given an index, share the string
+    // from the dictionary, else load the string.
+    if (dictionary && (value & 1)) {
+        string = dictionary->at(value >> 1);
+    } else {
+        // The size of the string.
+        std::size_t size = dictionary ? value >> 1 : value;
+
+        // Verify the size against the remaining input and allocation
+        // budget.
+        detail::verify_load_size(archive, size, 1, 1);
+
+        // Construct the string with the needed size.
+        auto loaded_string = std::make_shared<std::string>(size, '\0');
+
+        // Load the string characters.
+        if (size) {
+            archive(as_bytes(std::addressof((*loaded_string)[0]), size));
+        }
+
+        // Add the loaded string to the string dictionary.
+        if (dictionary) {
+            dictionary->add(loaded_string);
+        }
+
+        // Transfer the string.
+        string = std::move(loaded_string);
+    }
+
+    // Track the loaded string.
+    if (tracker) {
+        tracker->set(id, std::const_pointer_cast<std::string>(string));
+    }
+}
+#endif
+
+/**
+ * Serialize std::bitset, operates on loading (input) archives.
+ * The bits are packed eight per byte, least significant bit first,
+ * without a leading size.
+ */
+template <typename Archive,
+          std::size_t Count,
+          typename...,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::bitset<Count> & bitset)
+{
+    // Load the packed bits, one buffer at a time.
+    for (std::size_t offset{}; offset < Count;) {
+        unsigned char buffer[detail::bit_buffer_size];
+        auto count =
+            std::min<std::size_t>(Count - offset, sizeof(buffer) * 8);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(buffer, (count + 7) / 8));
+#else
+        if (auto result = archive(as_bytes(buffer, (count + 7) / 8));
+            !result) {
+            return result;
+        }
+#endif
+        detail::unpack_bits(buffer, count, bitset, offset);
+        offset += count;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::bitset, operates on saving (output) archives.
+ * The bits are packed eight per byte, least significant bit first,
+ * without a leading size.
+ */
+template <typename Archive,
+          std::size_t Count,
+          typename...,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::bitset<Count> & bitset)
+{
+    // Save the packed bits, one buffer at a time.
+    for (std::size_t offset{}; offset < Count;) {
+        unsigned char buffer[detail::bit_buffer_size];
+        auto count =
+            std::min<std::size_t>(Count - offset, sizeof(buffer) * 8);
+        detail::pack_bits(bitset, offset, count, buffer);
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(as_bytes(buffer, (count + 7) / 8));
+#else
+        if (auto result = archive(as_bytes(buffer, (count + 7) / 8));
+            !result) {
+            return result;
+        }
+#endif
+        offset += count;
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize arrays, operates on loading (input) archives.
+ * This overload is for non fundamental non enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
+                                      !std::is_enum<Item>::value>,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, Item (&array)[size])
+{
+    // Serialize every item.
+    for (auto & item : array) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize arrays, operates on loading (input) archives.
+ * This overload is for fundamental or enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
+                                      std::is_enum<Item>::value>,
+          typename = typename Archive::loading,
+          typename = void>
+auto serialize(Archive & archive, Item (&array)[size])
+{
+    return archive(as_bytes(array, size));
+}
+
+/**
+ * Serialize arrays, operates on saving (output) archives.
+ * This overload is for non fundamental non enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
+                                      !std::is_enum<Item>::value>,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const Item (&array)[size])
+{
+    // Serialize every item.
+    for (auto & item : array) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize arrays, operates on saving (output) archives.
+ * This overload is for fundamental or enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
+                                      std::is_enum<Item>::value>,
+          typename = typename Archive::saving,
+    typename = void>
+auto serialize(Archive & archive, const Item (&array)[size])
+{
+    return archive(as_bytes(array, size));
+}
+
+/**
+ * Serialize std::array, operates on loading (input) archives.
+ * This overload is for non fundamental non enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
+                                      !std::is_enum<Item>::value>,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::array<Item, size> & array)
+{
+    // Serialize every item.
+    for (auto & item : array) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::array, operates on loading (input) archives.
+ * This overload is for fundamental or enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
+                                      std::is_enum<Item>::value>,
+          typename = typename Archive::loading,
+          typename = void>
+auto serialize(Archive & archive, std::array<Item, size> & array)
+{
+    return archive(as_bytes(std::addressof(array[0]), size));
+}
+
+/**
+ * Serialize std::array, operates on saving (output) archives.
+ * This overload is for non fundamental non enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
+                                      !std::is_enum<Item>::value>,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::array<Item, size> & array)
+{
+    // Serialize every item.
+    for (auto & item : array) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(item);
+#else
+        if (auto result = archive(item); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::array, operates on saving (output) archives.
+ * This overload is for fundamental or enumeration types.
+ */
+template <typename Archive,
+          typename Item,
+          std::size_t size,
+          typename...,
+          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
+                                      std::is_enum<Item>::value>,
+          typename = typename Archive::saving,
+          typename = void>
+auto serialize(Archive & archive, const std::array<Item, size> & array)
+{
+    return archive(as_bytes(std::addressof(array[0]), size));
+}
+
+/**
+ * Serialize std::pair, operates on loading (input) archives.
+ */
+template <typename Archive,
+          typename First,
+          typename Second,
+          typename...,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::pair<First, Second> & pair)
+{
+    // Serialize first, then second.
+    return archive(pair.first, pair.second);
+}
+
+/**
+ * Serialize std::pair, operates on saving (output) archives.
+ */
+template <typename Archive,
+          typename First,
+          typename Second,
+          typename...,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::pair<First, Second> & pair)
+{
+    // Serialize first, then second.
+    return archive(pair.first, pair.second);
+}
+
+/**
+ * Serialize std::tuple, operates on loading (input) archives.
+ */
+template <typename Archive,
+          typename... TupleItems,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::tuple<TupleItems...> & tuple)
+{
+    // Delegate to a helper function with an index sequence.
+    return serialize(
+        archive, tuple, std::make_index_sequence<sizeof...(TupleItems)>());
+}
+
+/**
+ * Serialize std::tuple, operates on saving (output) archives.
+ */
+template <typename Archive,
+          typename... TupleItems,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::tuple<TupleItems...> & tuple)
+{
+    // Delegate to a helper function with an index sequence.
+    return serialize(
+        archive, tuple, std::make_index_sequence<sizeof...(TupleItems)>());
+}
+
+/**
+ * Serialize std::tuple, operates on loading (input) archives.
+ * This overload serves as a helper function that accepts an index
+ * sequence.
+ */
+template <typename Archive,
+          typename... TupleItems,
+          std::size_t... Indices,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive,
+               std::tuple<TupleItems...> & tuple,
+               std::index_sequence<Indices...>)
+{
+    return archive(std::get<Indices>(tuple)...);
+}
+
+/**
+ * Serialize std::tuple, operates on saving (output) archives.
+ * This overload serves as a helper function that accepts an index
+ * sequence.
+ */
+template <typename Archive,
+          typename... TupleItems,
+          std::size_t... Indices,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive,
+               const std::tuple<TupleItems...> & tuple,
+               std::index_sequence<Indices...>)
+{
+    return archive(std::get<Indices>(tuple)...);
+}
+
+#if __cplusplus >= 201703L
+/**
+ * Serialize std::optional, operates on loading (input) archives.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::optional<Type> & optional)
+{
+    // Load whether has value.
+    bool has_value{};
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(has_value);
+#else
+    if (auto result = archive(has_value); !result) {
+        return result;
+    }
+#endif
+
+    // If does not have a value.
+    if (!has_value) {
+        optional = std::nullopt;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        return;
+#else
+        return freestanding::error{error::success};
+#endif
+    }
+
+    // If the type is default constructible.
+    if constexpr (std::is_default_constructible_v<Type>) {
+        // Create the value if does not exist.
+        if (!optional) {
+            optional = Type{};
+        }
+
+        // Load the value.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(*optional);
+#else
+        if (auto result = archive(*optional); !result) {
+            return result;
+        }
+#endif
+    } else {
+        // The object storage.
+        std::aligned_storage_t<sizeof(Type), alignof(Type)> storage;
+
+        // Create the object at the storage.
+        std::unique_ptr<Type, void (*)(Type *)> object(
+            access::placement_new<Type>(std::addressof(storage)),
+            [](auto pointer) { access::destruct(*pointer); });
+
+        // Load the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(*object);
+#else
+        if (auto result = archive(*optional); !result) {
+            return result;
+        }
+#endif
+
+        // Assign the loaded object.
+        optional = std::move(*object);
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::optional, operates on saving (output) archives.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::optional<Type> & optional)
+{
+    // Save has value.
+    bool has_value = optional.has_value();
+
+    // If has value, save it.
+    if (has_value) {
+        return archive(has_value, *optional);
+    } else {
+        return archive(has_value);
+    }
+}
+
+/**
+ * Serialize std::variant, operates on loading (input) archives.
+ */
+template <typename Archive,
+          typename... Types,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::variant<Types...> & variant)
+{
+    // Test for maximum number of types.
+    static_assert(sizeof...(Types) < 0xff, "Max variant types reached.");
+
+    // The variant index.
+    unsigned char index{};
+
+    // Load the index.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(index);
+#else
+    if (auto result = archive(index); !result) {
+        return result;
+    }
+#endif
+
+    // Check that loaded index is inside bounds.
+    if (index >= sizeof...(Types)) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw variant_index_out_of_range("Variant index out of range");
+#else
+        return freestanding::error{error::out_of_range};
+#endif
+    }
+
+    // The variant type.
+    using variant_type = std::variant<Types...>;
+
+    // Loader type.
+    using loader_type =
+        void (*)(Archive & archive, variant_type & variant);
+
+    // Loaders per variant index.
+    static constexpr loader_type loaders[] = {[](auto & archive,
+                                                 auto & variant) {
+        // If the type is default constructible.
+        if constexpr (std::is_default_constructible_v<Types>) {
+            // If does not have the needed type, assign it.
+            if (!std::get_if<Types>(&variant)) {
+                variant = Types{};
+            }
+
+            // Load the value.
+            return archive(*std::get_if<Types>(&variant));
+        } else {
+            // The object storage.
+            std::aligned_storage_t<sizeof(Types), alignof(Types)> storage;
+
+            // Create the object at the storage.
+            std::unique_ptr<Types, void (*)(Types *)> object(
+                access::placement_new<Types>(std::addressof(storage)),
+                [](auto pointer) { access::destruct(*pointer); });
+
+            // Load the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            archive(*object);
+#else
+            if (auto result = archive(*object); !result) {
+                return result;
+            }
+#endif
+
+            // Assign the loaded object.
+            variant = std::move(*object);
+        }
+    }...};
+
+    // Execute the appropriate loader.
+    return loaders[index](archive, variant);
+}
+
+/**
+ * Serialize std::variant, operates on saving (output) archives.
+ */
+template <typename Archive,
+          typename... Types,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::variant<Types...> & variant)
+{
+    // Test for maximum number of types.
+    static_assert(sizeof...(Types) < 0xff, "Max variant types reached.");
+
+    // The variant index.
+    auto variant_index = variant.index();
+
+    // Disallow serializations of valueless variant.
+    if (std::variant_npos == variant_index) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw attempt_to_serialize_valueless_variant(
+            "Cannot serialize a valueless variant.");
+#else
+        return freestanding::error{error::variant_is_valueless};
+#endif
+    }
+
+    // The index to save.
+    auto index = static_cast<unsigned char>(variant_index & 0xff);
+
+    // Save the variant object.
+    return std::visit(
+        [index, &archive](auto & object) {
+            return archive(index, object);
+        },
+        variant);
+}
+
+namespace detail
+{
+/**
+ * The maximum number of members of aggregates that are serialized
+ * without a serialize method.
+ */
+constexpr std::size_t max_aggregate_members = 16;
+
+/**
+ * A type that converts to any member type, used to count the members of
+ * aggregates.
+ */
+struct any_member
+{
+    template <typename Type>
+    operator Type() const;
+};
+
+/**
+ * Maps an index to any_member.
+ */
+template <std::size_t>
+using any_member_t = any_member;
+
+/**
+ * Tests if an aggregate can be initialized with the given count of
+ * members.
+ */
+template <typename Type, typename Indices, typename = void>
+struct is_aggregate_initializable : std::false_type
+{
+};
+
+template <typename Type, std::size_t... Indices>
+struct is_aggregate_initializable<
+    Type,
+    std::index_sequence<Indices...>,
+    void_t<decltype(Type{any_member_t<Indices>{}...})>> : std::true_type
+{
+};
+
+/**
+ * The number of members of an aggregate, the largest count of members it
+ * can be initialized with.
+ */
+template <typename Type, std::size_t Count = max_aggregate_members>
+struct aggregate_member_count
+    : std::conditional_t<
+          is_aggregate_initializable<Type,
+                                     std::make_index_sequence<Count>>::value,
+          std::integral_constant<std::size_t, Count>,
+          aggregate_member_count<Type, Count - 1>>
+{
+};
+
+template <typename Type>
+struct aggregate_member_count<Type, 0>
+    : std::integral_constant<std::size_t, 0>
+{
+};
+
+/**
+ * Tests if the type is std::array.
+ */
+template <typename Type>
+struct is_std_array : std::false_type
+{
+};
+
+template <typename Type, std::size_t Size>
+struct is_std_array<std::array<Type, Size>> : std::true_type
+{
+};
+
+/**
+ * Tests if the item has a serialize method for the archive.
+ */
+template <typename Archive, typename Item, typename = void>
+struct has_serialize_method : std::false_type
+{
+};
+
+template <typename Archive, typename Item>
+struct has_serialize_method<
+    Archive,
+    Item,
+    void_t<decltype(Item::serialize(std::declval<Archive &>(),
+                                    std::declval<Item &>()))>>
+    : std::true_type
+{
+};
+
+/**
+ * Tests if the item is an aggregate that is serialized member by member
+ * without a serialize method.
+ */
+template <typename Archive, typename Item>
+struct is_serializable_aggregate
+    : std::integral_constant<
+          bool,
+          std::is_class_v<Item> && std::is_aggregate_v<Item> &&
+              !is_std_array<std::remove_const_t<Item>>::value &&
+              !has_serialize_method<Archive, Item>::value>
+{
+};
+
+/**
+ * Calls the function with references to the members of the aggregate.
+ */
+template <typename Item, typename Function>
+auto visit_members(Item & item, Function && function)
+{
+    // The number of members.
+    constexpr auto count =
+        aggregate_member_count<std::remove_const_t<Item>>::value;
+
+    static_assert(
+        !is_aggregate_initializable<
+            std::remove_const_t<Item>,
+            std::make_index_sequence<max_aggregate_members + 1>>::value,
+        "Too many aggregate members, add a serialize method.");
+
+    if constexpr (count == 0) {
+        return function();
+    } else if constexpr (count == 1) {
+        auto & [m1] = item;
+        return function(m1);
+    } else if constexpr (count == 2) {
+        auto & [m1, m2] = item;
+        return function(m1, m2);
+    } else if constexpr (count == 3) {
+        auto & [m1, m2, m3] = item;
+        return function(m1, m2, m3);
+    } else if constexpr (count == 4) {
+        auto & [m1, m2, m3, m4] = item;
+        return function(m1, m2, m3, m4);
+    } else if constexpr (count == 5) {
+        auto & [m1, m2, m3, m4, m5] = item;
+        return function(m1, m2, m3, m4, m5);
+    } else if constexpr (count == 6) {
+        auto & [m1, m2, m3, m4, m5, m6] = item;
+        return function(m1, m2, m3, m4, m5, m6);
+    } else if constexpr (count == 7) {
+        auto & [m1, m2, m3, m4, m5, m6, m7] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7);
+    } else if constexpr (count == 8) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8);
+    } else if constexpr (count == 9) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    } else if constexpr (count == 10) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    } else if constexpr (count == 11) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    } else if constexpr (count == 12) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+    } else if constexpr (count == 13) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+    } else if constexpr (count == 14) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+    } else if constexpr (count == 15) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+    } else if constexpr (count == 16) {
+        auto & [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16] = item;
+        return function(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16);
+    }
+}
+
+/**
+ * An archive that loads only the selected items of an object.
+ */
+template <typename Archive, typename Selector>
+class projecting_archive;
+
+/**
+ * Tests if the archive is a projecting archive, which numbers the items
+ * it is given, so that aggregates are serialized member by member.
+ */
+template <typename Archive>
+struct is_projecting_archive : std::false_type
+{
+};
+
+template <typename Archive, typename Selector>
+struct is_projecting_archive<projecting_archive<Archive, Selector>>
+    : std::true_type
+{
+};
+} // namespace detail
+
+/**
+ * Serialize aggregates without a serialize method, member by member.
+ * Aggregates of fundamental and enumeration members without padding are
+ * serialized as bytes data, unless only selected members are loaded.
+ * Supports aggregates without base classes and array members, of up to
+ * detail::max_aggregate_members members.
+ */
+template <typename Archive,
+          typename Item,
+          typename...,
+          typename = std::enable_if_t<
+              detail::is_serializable_aggregate<Archive, Item>::value>>
+auto serialize(Archive & archive, Item & item)
+{
+    return detail::visit_members(item, [&](auto &... members) {
+        if constexpr (!detail::is_projecting_archive<Archive>::value &&
+                      std::has_unique_object_representations_v<
+                          std::remove_const_t<Item>> &&
+                      detail::all_of<(
+                          std::is_fundamental_v<
+                              std::remove_reference_t<decltype(members)>> ||
+                          std::is_enum_v<std::remove_reference_t<
+                              decltype(members)>>)...>::value) {
+            return archive(as_bytes(std::addressof(item), 1));
+        } else {
+            return archive(members...);
+        }
+    });
+}
+#endif
+
+/**
+ * Serialize std::unique_ptr of non polymorphic, in case of a loading
+ * (input) archive.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename =
+              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::unique_ptr<Type> & object)
+{
+    // Construct a new object.
+    auto loaded_object = access::make_unique<Type>();
+
+    // Serialize the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(*loaded_object);
+#else
+    if (auto result = archive(*loaded_object); !result) {
+        return result;
+    }
+#endif
+
+    // Transfer the object.
+    object.reset(loaded_object.release());
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::unique_ptr of non polymorphic, in case of a saving
+ * (output) archive.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename =
+              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::unique_ptr<Type> & object)
+{
+    // Prevent serialization of null pointers.
+    if (nullptr == object) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw attempt_to_serialize_null_pointer_error(
+            "Attempt to serialize null pointer.");
+#else
+        return freestanding::error{error::null_pointer_serialization};
+#endif
+    }
+
+    // Serialize the object.
+    return archive(*object);
+}
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+/**
+ * Serialize std::unique_ptr of polymorphic, in case of a loading (input)
+ * archive.
+ */
+template <
+    typename Archive,
+    typename Type,
+    typename...,
+    typename = std::enable_if_t<std::is_base_of<polymorphic, Type>::value>,
+    typename = typename Archive::loading,
+    typename = void>
+void serialize(Archive & archive, std::unique_ptr<Type> & object)
+{
+    std::unique_ptr<polymorphic> loaded_type;
+
+    // Get the instance of the polymorphic registry.
+    auto & registry_instance = registry<Archive>::get_instance();
+
+    // Serialize the object using the registry.
+    registry_instance.serialize(archive, loaded_type);
+
+    // Archives with sticky errors may load no object.
+    if (!loaded_type) {
+        object = nullptr;
+        return;
+    }
+
+    try {
+        // Check if the loaded type is convertible to Type.
+        object.reset(&dynamic_cast<Type &>(*loaded_type));
+
+        // Release the object.
+        loaded_type.release();
+    } catch (const std::bad_cast &) {
+        // The loaded type was not convertible to Type.
+        throw polymorphic_type_mismatch_error(
+            "Polymorphic serialization type mismatch.");
+    }
+}
+
+/**
+ * Serialize std::unique_ptr of polymorphic, in case of a saving (output)
+ * archive.
+ */
+template <
+    typename Archive,
+    typename Type,
+    typename...,
+    typename = std::enable_if_t<std::is_base_of<polymorphic, Type>::value>,
+    typename = typename Archive::saving,
+    typename = void>
+void serialize(Archive & archive, const std::unique_ptr<Type> & object)
+{
+    // Prevent serialization of null pointers.
+    if (nullptr == object) {
+        throw attempt_to_serialize_null_pointer_error(
+            "Attempt to serialize null pointer.");
+    }
+
+    // Get the instance of the polymorphic registry.
+    auto & registry_instance = registry<Archive>::get_instance();
+
+    // Serialize the object using the registry.
+    registry_instance.serialize(archive, *object);
+}
+#endif // ZPP_SERIALIZER_FREESTANDING
+
+/**
+ * Serialize std::shared_ptr of non polymorphic, in case of a loading
+ * (input) archive.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename =
+              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
+          typename = typename Archive::loading>
+auto serialize(Archive & archive, std::shared_ptr<Type> & object)
+{
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    // If tracking objects, load the reference.
+    if (auto tracker = detail::tracker_of(archive, 0)) {
+        size_type reference{};
+        archive(reference);
+
+        // The type key of the object.
+        auto type = detail::type_key<std::remove_cv_t<Type>>();
+
+        // If already loaded, share the loaded object.
+        if (reference) {
+            object = std::static_pointer_cast<Type>(
+                tracker->at(reference - 1, type));
+            return;
+        }
+
+        // Construct and track the object, then load it.
+        std::shared_ptr<Type> loaded_object = access::make_unique<Type>();
+        tracker->add(std::const_pointer_cast<std::remove_cv_t<Type>>(
+                         loaded_object),
+                     type);
+        archive(*loaded_object);
+        object = std::move(loaded_object);
+        return;
+    }
+#endif
+
+    // Construct a new object.
+    auto loaded_object = access::make_unique<Type>();
+
+    // Serialize the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    archive(*loaded_object);
+#else
+    if (auto result = archive(*loaded_object); !result) {
+        return result;
+    }
+#endif
+
+    // Transfer the object.
+    object.reset(loaded_object.release());
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Serialize std::shared_ptr of non polymorphic, in case of a saving
+ * (output) archive.
+ */
+template <typename Archive,
+          typename Type,
+          typename...,
+          typename =
+              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
+          typename = typename Archive::saving>
+auto serialize(Archive & archive, const std::shared_ptr<Type> & object)
+{
+    // Prevent serialization of null pointers.
+    if (nullptr == object) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        throw attempt_to_serialize_null_pointer_error(
+            "Attempt to serialize null pointer.");
+#else
+        return freestanding::error{error::null_pointer_serialization};
+#endif
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    // If tracking objects, save the reference, and stop unless this is
+    // the first occurrence of the object.
+    if (auto tracker = detail::tracker_of(archive, 0)) {
+        auto reference = tracker->save(
+            object.get(), detail::type_key<std::remove_cv_t<Type>>());
+        archive(static_cast<size_type>(reference));
+        if (reference) {
+            return;
+        }
+    }
+#endif
+
+    // Serialize the object.
+    return archive(*object);
+}
+
+/**
+ * Represents a container object with specific
+ * size type requirements.
+ */
+template <typename SizeType, typename Container>
+class sized_container
+{
+public:
+    /**
+     * Must be class type.
+     */
+    static_assert(std::is_class<Container>::value,
+                  "Container must be a class type.");
+
+    /**
+     * Must be unsigned integral type.
+     */
+    static_assert(std::is_unsigned<SizeType>::value,
+                  "Size must be an unsigned integral type.");
+
+    /*
+     * Construct the sized container.
+     */
+    explicit sized_container(Container & container) : container(container)
+    {
+    }
+
+    /**
+     * Call serialize directly with the size type parameter.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        using zpp::serializer::serialize;
+        return serialize<Archive, Container, SizeType>(archive,
+                                                       self.container);
+    }
+
+    /**
+     * The wrapped container type.
+     */
+    Container & container;
+};
+
+/**
+ * Creates a wrapper object of sized_container to
+ * allow serialization with specific size type requirements.
+ */
+template <typename SizeType, typename Container>
+auto size_is(Container && container)
+{
+    return sized_container<SizeType, std::remove_reference_t<Container>>(
+        container);
+}
+
+namespace detail
+{
+/**
+ * Returns the items of an owned array held by std::unique_ptr.
+ */
+template <typename Item, typename Deleter>
+Item * array_data(const std::unique_ptr<Item[], Deleter> & pointer) noexcept
+{
+    return pointer.get();
+}
+
+/**
+ * Returns the items of an owned array held by a raw pointer.
+ */
+template <typename Item>
+Item * array_data(Item * pointer) noexcept
+{
+    return pointer;
+}
+
+/**
+ * Replaces the owned array held by std::unique_ptr with the given items.
+ * The items are allocated with new[], so only the default deleter may
+ * own them.
+ */
+template <typename Item, typename Deleter>
+void adopt_array(std::unique_ptr<Item[], Deleter> & pointer,
+                 std::unique_ptr<Item[]> items) noexcept
+{
+    static_assert(std::is_same<Deleter, std::default_delete<Item[]>>::value,
+                  "Only arrays with the default deleter may be loaded.");
+    pointer.reset(items.release());
+}
+
+/**
+ * Replaces the owned array held by a raw pointer, which must have been
+ * allocated with new[], with the given items.
+ */
+template <typename Item>
+void adopt_array(Item *& pointer, std::unique_ptr<Item[]> items) noexcept
+{
+    delete[] pointer;
+    pointer = items.release();
+}
+
+/**
+ * Serialize the items of an array.
+ * This overload is for fundamental and enumeration types, that are
+ * serialized as bytes data.
+ */
+template <typename Archive,
+          typename Item,
+          typename...,
+          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
+                                      std::is_enum<Item>::value>>
+auto serialize_array_items(Archive & archive, Item * items, std::size_t size)
+{
+    // If the size is zero, return.
+    if (!size) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        return;
+#else
+        return freestanding::error{error::success};
+#endif
+    }
+
+    // Serialize the bytes data.
+    return archive(as_bytes(items, size));
+}
+
+/**
+ * Serialize the items of an array.
+ * This overload is for any other type, serialized item by item.
+ */
+template <typename Archive,
+          typename Item,
+          typename...,
           typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
                                       !std::is_enum<Item>::value>,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, Item (&array)[size])
+          typename = void>
+auto serialize_array_items(Archive & archive, Item * items, std::size_t size)
+{
+    // Serialize all the items.
+    for (std::size_t i{}; i < size; ++i) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(items[i]);
+#else
+        if (auto result = archive(items[i]); !result) {
+            return result;
+        }
+#endif
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+
+/**
+ * Allocates and loads an array of 'count' items.
+ * This overload is for items serialized in at least one byte, whose
+ * count is bounded by the input.
+ */
+template <typename Archive, typename Item>
+auto load_array_items(Archive & archive,
+                      std::unique_ptr<Item[]> & items,
+                      std::size_t count,
+                      std::true_type)
+{
+    items.reset(count ? new Item[count] : nullptr);
+    return serialize_array_items(archive, items.get(), count);
+}
+
+/**
+ * Allocates and loads an array of 'count' items.
+ * This overload is for items that may be serialized in no bytes, whose
+ * count is not bounded by the input, so the items are loaded into a
+ * buffer that grows as items are loaded, and then moved into the array.
+ */
+template <typename Archive, typename Item>
+auto load_array_items(Archive & archive,
+                      std::unique_ptr<Item[]> & items,
+                      std::size_t count,
+                      std::false_type)
+{
+    std::vector<Item> buffer;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    load_items(
+        archive, buffer, count, 0, std::random_access_iterator_tag{});
+#else
+    if (auto result = load_items(
+            archive, buffer, count, 0, std::random_access_iterator_tag{});
+        !result) {
+        return result;
+    }
+#endif
+
+    items.reset(count ? new Item[count] : nullptr);
+    std::move(buffer.begin(), buffer.end(), items.get());
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+} // namespace detail
+
+/**
+ * Represents an owned array with a separately stored size, held by
+ * std::unique_ptr<Item[]> or by a raw pointer allocated with new[].
+ * The array is serialized like a container of its items, with a leading
+ * size. When loading, a new array of the loaded size is allocated and
+ * replaces the existing one.
+ */
+template <typename Pointer, typename Size>
+class sized_array_wrapper
+{
+public:
+    /**
+     * Must be integral type.
+     */
+    static_assert(std::is_integral<Size>::value,
+                  "Size must be an integral type.");
+
+    /**
+     * The item type.
+     */
+    using item_type = std::remove_pointer_t<decltype(
+        detail::array_data(std::declval<Pointer &>()))>;
+
+    /**
+     * Construct the sized array from the pointer and the size.
+     */
+    sized_array_wrapper(Pointer & pointer, Size & size) :
+        pointer(pointer),
+        size(size)
+    {
+    }
+
+    /**
+     * Serialize the sized array.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_array(archive, self.pointer, self.size);
+    }
+
+    /**
+     * The wrapped pointer.
+     */
+    Pointer & pointer;
+
+    /**
+     * The wrapped size.
+     */
+    Size & size;
+
+private:
+    /**
+     * Serialize the sized array, in case of a loading (input) archive.
+     */
+    template <typename Archive,
+              typename ArrayPointer,
+              typename ArraySize,
+              typename...,
+              typename = typename Archive::loading>
+    static auto
+    serialize_array(Archive & archive, ArrayPointer & pointer, ArraySize & size)
+    {
+        size_type count{};
+
+        // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(count);
+#else
+        if (auto result = archive(count); !result) {
+            return result;
+        }
+#endif
+
+        // Verify the size against the remaining input and allocation
+        // budget.
+        using value_type = std::remove_const_t<item_type>;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        detail::verify_load_size(
+            archive,
+            count,
+            detail::min_serialized_size<value_type>::value,
+            sizeof(value_type));
+#else
+        if (auto result = detail::verify_load_size(
+                archive,
+                count,
+                detail::min_serialized_size<value_type>::value,
+                sizeof(value_type));
+            !result) {
+            return result;
+        }
+#endif
+
+        // Allocate and load the items.
+        using bounded = std::integral_constant<
+            bool,
+            0 != detail::min_serialized_size<value_type>::value>;
+        std::unique_ptr<value_type[]> items;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        detail::load_array_items(archive, items, count, bounded{});
+#else
+        if (auto result =
+                detail::load_array_items(archive, items, count, bounded{});
+            !result) {
+            return result;
+        }
+#endif
+
+        // Replace the array.
+        detail::adopt_array(pointer, std::move(items));
+        size = static_cast<ArraySize>(count);
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+    /**
+     * Serialize the sized array, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename ArrayPointer,
+              typename ArraySize,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static auto serialize_array(Archive & archive,
+                                const ArrayPointer & pointer,
+                                const ArraySize & size)
+    {
+        // Save the array size.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(static_cast<size_type>(size));
+#else
+        if (auto result = archive(static_cast<size_type>(size)); !result) {
+            return result;
+        }
+#endif
+
+        // Serialize all the items.
+        return detail::serialize_array_items(
+            archive,
+            detail::array_data(pointer),
+            static_cast<std::size_t>(size));
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Serialize the sized array, in case of a skipping archive.
+     * The items are skipped, and the array and size are left untouched.
+     */
+    template <typename ArrayPointer, typename ArraySize>
+    static void
+    serialize_array(skipping_archive & archive, ArrayPointer &, ArraySize &)
+    {
+        size_type count{};
+        archive(count);
+        detail::skip_items<std::remove_const_t<item_type>>(archive, count);
+    }
+#endif
+};
+
+/**
+ * Creates a wrapper object of sized_array_wrapper to allow serialization
+ * of an owned array with a separately stored size.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::sized_array(self.m_samples, self.m_count));
+ * ~~~
+ */
+template <typename Pointer, typename Size>
+auto sized_array(Pointer && pointer, Size && size)
+{
+    return sized_array_wrapper<std::remove_reference_t<Pointer>,
+                               std::remove_reference_t<Size>>(pointer, size);
+}
+
+/**
+ * The default number of items in a chunk of a stream.
+ */
+constexpr std::size_t default_stream_chunk_size = 1024;
+
+namespace detail
+{
+/**
+ * Loads a stream of items saved with stream_of(), one chunk at a time,
+ * invoking the given function with every loaded item.
+ */
+template <typename Item, typename Archive, typename Function>
+auto for_each_stream_item(Archive & archive, Function && function)
+{
+    std::vector<Item> chunk;
+    while (true) {
+        // Load the next chunk.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(chunk);
+#else
+        if (auto result = archive(chunk); !result) {
+            return result;
+        }
+#endif
+
+        // The stream ends with an empty chunk.
+        if (chunk.empty()) {
+            break;
+        }
+
+        for (auto & item : chunk) {
+            function(std::move(item));
+        }
+    }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+    return freestanding::error{error::success};
+#endif
+}
+} // namespace detail
+
+/**
+ * Represents a range of unknown length that is serialized as a stream of
+ * chunks, each serialized like a vector of up to a chunk size items,
+ * terminated by an empty chunk. Saving requires only a single pass over
+ * the range, and both saving and loading hold at most one chunk at a
+ * time. Loading appends the items to the container after clearing it.
+ */
+template <typename Range>
+class stream_wrapper
+{
+public:
+    /**
+     * The item type.
+     */
+    using item_type =
+        std::decay_t<decltype(*std::begin(std::declval<Range &>()))>;
+
+    /**
+     * Construct the stream from the range and the chunk size.
+     */
+    stream_wrapper(Range & range, std::size_t chunk_size) :
+        range(range),
+        chunk_size(chunk_size ? chunk_size : 1)
+    {
+    }
+
+    /**
+     * Serialize the stream.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_stream(archive, self.range, self.chunk_size);
+    }
+
+    /**
+     * The wrapped range.
+     */
+    Range & range;
+
+    /**
+     * The number of items in a chunk.
+     */
+    std::size_t chunk_size{};
+
+private:
+    /**
+     * Serialize the stream, in case of a loading (input) archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::loading>
+    static auto serialize_stream(Archive & archive, Items & range, std::size_t)
+    {
+        range.clear();
+        return detail::for_each_stream_item<item_type>(
+            archive, [&](auto && item) {
+                range.insert(range.end(), std::move(item));
+            });
+    }
+
+    /**
+     * Serialize the stream, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static auto serialize_stream(Archive & archive,
+                                 Items & range,
+                                 std::size_t chunk_size)
+    {
+        std::vector<item_type> chunk;
+        chunk.reserve(chunk_size);
+
+        // Save the items, one chunk at a time.
+        for (auto && item : range) {
+            chunk.emplace_back(std::forward<decltype(item)>(item));
+            if (chunk.size() == chunk_size) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+                archive(chunk);
+#else
+                if (auto result = archive(chunk); !result) {
+                    return result;
+                }
+#endif
+                chunk.clear();
+            }
+        }
+
+        // Save the last chunk, if not empty.
+        if (!chunk.empty()) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            archive(chunk);
+#else
+            if (auto result = archive(chunk); !result) {
+                return result;
+            }
+#endif
+        }
+
+        // Save the terminating empty chunk.
+        return archive(size_type{});
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Serialize the stream, in case of a skipping archive.
+     * The chunks are skipped up to the empty chunk, and the range is
+     * left untouched.
+     */
+    template <typename Items>
+    static void
+    serialize_stream(skipping_archive & archive, Items &, std::size_t)
+    {
+        while (true) {
+            size_type size{};
+            archive(size);
+            if (!size) {
+                break;
+            }
+            detail::skip_items<item_type>(archive, size);
+        }
+    }
+#endif
+};
+
+/**
+ * Creates a wrapper object of stream_wrapper to allow serialization of
+ * a range of unknown length, such as a generator, as a stream of chunks.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::stream_of(self.m_rows));
+ * ~~~
+ */
+template <typename Range>
+auto stream_of(Range && range,
+               std::size_t chunk_size = default_stream_chunk_size)
+{
+    return stream_wrapper<std::remove_reference_t<Range>>(range,
+                                                          chunk_size);
+}
+
+/**
+ * Represents a visitor of a stream of items, that invokes a function with
+ * every loaded item rather than building a container.
+ */
+template <typename Item, typename Function>
+class stream_visitor
+{
+public:
+    /**
+     * Construct the visitor from the function.
+     */
+    explicit stream_visitor(Function & function) : function(function)
+    {
+    }
+
+    /**
+     * Load the stream, in case of a loading (input) archive.
+     */
+    template <typename Archive,
+              typename Self,
+              typename...,
+              typename = typename Archive::loading>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return detail::for_each_stream_item<Item>(archive, self.function);
+    }
+
+    /**
+     * The function to invoke with every loaded item.
+     */
+    Function & function;
+};
+
+/**
+ * Loads a stream of items saved with stream_of(), from the given archive,
+ * invoking the given function with every loaded item, so that items are
+ * decoded one chunk at a time without building a container.
+ * Example:
+ * ~~~
+ * zpp::serializer::for_each_loaded<row>(in, [&](row && loaded) {
+ *     table.add(std::move(loaded));
+ * });
+ * ~~~
+ */
+template <typename Item, typename Archive, typename Function>
+auto for_each_loaded(Archive & archive, Function && function)
+{
+    return archive(
+        stream_visitor<Item, std::remove_reference_t<Function>>(function));
+}
+
+namespace detail
+{
+/**
+ * Checks if the archive saves every item as its plain serialized bytes,
+ * so that previously serialized bytes may be saved in place of the item.
+ */
+template <typename Archive>
+struct is_byte_stream_archive : std::false_type
+{
+};
+
+/**
+ * Checks if the archive saves every item as its plain serialized bytes.
+ */
+template <>
+struct is_byte_stream_archive<basic_memory_output_archive> : std::true_type
+{
+};
+
+/**
+ * Checks if the archive saves every item as its plain serialized bytes.
+ */
+template <>
+struct is_byte_stream_archive<hashing_archive> : std::true_type
+{
+};
+
+/**
+ * Checks if the archive saves every item as its plain serialized bytes.
+ */
+template <>
+struct is_byte_stream_archive<equality_archive> : std::true_type
+{
+};
+} // namespace detail
+
+/**
+ * Holds an immutable object together with its serialized bytes, that are
+ * computed on the first save and then saved in place of the object.
+ * Mutating the object through mutate() invalidates the bytes.
+ * Archives with a string dictionary or an object tracker, whose state
+ * depends on the items saved before, save the object instead.
+ * To save the same object from multiple threads, compute the bytes
+ * beforehand using encoding().
+ */
+template <typename Type>
+class cached_encoding
+{
+public:
+    /**
+     * Constructs a default object.
+     */
+    cached_encoding() = default;
+
+    /**
+     * Constructs the object from the given value.
+     */
+    explicit cached_encoding(Type value) : m_value(std::move(value))
+    {
+    }
+
+    /**
+     * Returns the object.
+     */
+    const Type & get() const noexcept
+    {
+        return m_value;
+    }
+
+    /**
+     * Returns the object.
+     */
+    const Type & operator*() const noexcept
+    {
+        return m_value;
+    }
+
+    /**
+     * Returns the object.
+     */
+    const Type * operator->() const noexcept
+    {
+        return std::addressof(m_value);
+    }
+
+    /**
+     * Returns the object for mutation, invalidating its serialized
+     * bytes.
+     */
+    Type & mutate() noexcept
+    {
+        invalidate();
+        return m_value;
+    }
+
+    /**
+     * Invalidates the serialized bytes of the object.
+     */
+    void invalidate() noexcept
+    {
+        m_encoding.clear();
+        m_encoded = false;
+    }
+
+    /**
+     * Returns the serialized bytes of the object, computing them if
+     * needed.
+     */
+    const std::vector<unsigned char> & encoding() const
+    {
+        if (!m_encoded) {
+            encode();
+        }
+        return m_encoding;
+    }
+
+    /**
+     * Serialize the object.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_value(archive, self);
+    }
+
+private:
+    /**
+     * Serialize the object, in case of a loading (input) archive.
+     */
+    template <typename Archive,
+              typename Self,
+              typename...,
+              typename = typename Archive::loading>
+    static auto serialize_value(Archive & archive, Self & self)
+    {
+        self.invalidate();
+        return archive(self.m_value);
+    }
+
+    /**
+     * Serialize the object, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename Self,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static auto serialize_value(Archive & archive, Self & self)
+    {
+        // Save the object, if its bytes cannot be saved in its place.
+        if (!detail::is_byte_stream_archive<Archive>::value
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            || detail::dictionary_of(archive, 0) ||
+            detail::tracker_of(archive, 0)
+#endif
+        ) {
+            return archive(self.m_value);
+        }
+
+        // Compute the serialized bytes, if needed.
+        if (!self.m_encoded) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            self.encode();
+#else
+            if (auto result = self.encode(); !result) {
+                return result;
+            }
+#endif
+        }
+
+        // Save the serialized bytes.
+        return archive(as_bytes(self.m_encoding.data(),
+                                self.m_encoding.size()));
+    }
+
+    /**
+     * Computes the serialized bytes of the object.
+     */
+    auto encode() const
+    {
+        std::vector<unsigned char> encoding;
+        memory_output_archive out(encoding);
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        out(m_value);
+#else
+        if (auto result = out(m_value); !result) {
+            return result;
+        }
+#endif
+
+        m_encoding = std::move(encoding);
+        m_encoded = true;
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+    /**
+     * The object.
+     */
+    Type m_value{};
+
+    /**
+     * The serialized bytes of the object.
+     */
+    mutable std::vector<unsigned char> m_encoding;
+
+    /**
+     * Whether the serialized bytes are computed.
+     */
+    mutable bool m_encoded{};
+};
+
+namespace detail
+{
+/**
+ * The maximum serialized size of a type, known at compile time.
+ * Defined for fundamental and enumeration types, fixed arrays,
+ * std::pair, std::tuple, std::optional and std::variant of such types,
+ * and classes whose constexpr serialize method makes a single archive
+ * call of such types, and returns its result.
+ */
+template <typename Type, typename = void>
+struct max_serialized_size
+{
+    static_assert(sizeof(Type) == 0,
+                  "Type has no compile time maximum serialized size.");
+};
+
+/**
+ * An archive that computes the serialized size of items at compile time,
+ * as given by the size trait for a tuple of the items, in the type of
+ * its result, and counts its calls, so that serialize methods that make
+ * more than one call are refused.
+ */
+template <template <typename, typename> class SerializedSize>
+class size_archive
+{
+public:
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Returns the serialized size of the items, as an integral constant.
+     */
+    template <typename... Items>
+    constexpr auto operator()(Items &&...) noexcept
+    {
+        ++m_calls;
+        return std::integral_constant<
+            std::size_t,
+            SerializedSize<std::tuple<std::remove_cv_t<
+                               std::remove_reference_t<Items>>...>,
+                           void>::value>{};
+    }
+
+    /**
+     * Returns the number of calls made to the archive.
+     */
+    constexpr std::size_t calls() const noexcept
+    {
+        return m_calls;
+    }
+
+private:
+    /**
+     * The number of calls made to the archive.
+     */
+    std::size_t m_calls{};
+};
+
+/**
+ * An archive that computes the maximum serialized size of items at
+ * compile time.
+ */
+using max_size_archive = size_archive<max_serialized_size>;
+
+/**
+ * Returns the number of archive calls the serialize method of the type
+ * makes with a size archive, in a constant expression, which requires
+ * the serialize method to be constexpr. Only the result of the last
+ * call is returned, so any other number means the size is not known.
+ */
+template <typename Type, template <typename, typename> class SerializedSize>
+constexpr std::size_t size_archive_calls()
+{
+    size_archive<SerializedSize> archive;
+    Type object{};
+    Type::serialize(archive, object);
+    return archive.calls();
+}
+
+/**
+ * The maximum serialized size from the result of a serialize method.
+ */
+template <typename Result, typename = void>
+struct max_serialized_size_of_result : Result
+{
+};
+
+/**
+ * The maximum serialized size from the result of a serialize method.
+ * This overload is for serialize methods that return nothing.
+ */
+template <typename Result>
+struct max_serialized_size_of_result<
+    Result,
+    std::enable_if_t<std::is_void<Result>::value>>
+{
+    static_assert(!std::is_void<Result>::value,
+                  "The serialize method must return the result of a single "
+                  "archive call for a compile time maximum serialized size.");
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for fundamental and enumeration types.
+ */
+template <typename Type>
+struct max_serialized_size<
+    Type,
+    std::enable_if_t<std::is_fundamental<Type>::value ||
+                     std::is_enum<Type>::value>>
+    : std::integral_constant<std::size_t, sizeof(Type)>
+{
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for arrays.
+ */
+template <typename Type, std::size_t Size>
+struct max_serialized_size<Type[Size]>
+    : std::integral_constant<std::size_t,
+                             max_serialized_size<Type>::value * Size>
+{
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for std::array.
+ */
+template <typename Type, std::size_t Size>
+struct max_serialized_size<std::array<Type, Size>>
+    : max_serialized_size<Type[Size]>
+{
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for std::pair.
+ */
+template <typename First, typename Second>
+struct max_serialized_size<std::pair<First, Second>>
+    : sum<max_serialized_size<std::remove_const_t<First>>::value,
+          max_serialized_size<std::remove_const_t<Second>>::value>
+{
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for std::tuple.
+ */
+template <typename... Types>
+struct max_serialized_size<std::tuple<Types...>>
+    : sum<max_serialized_size<std::remove_const_t<Types>>::value...>
+{
+};
+
+#if __cplusplus >= 201703L
+/**
+ * The maximum serialized size of a type.
+ * This overload is for std::optional, that is serialized as whether it
+ * has a value, followed by the value.
+ */
+template <typename Type>
+struct max_serialized_size<std::optional<Type>>
+    : sum<sizeof(bool), max_serialized_size<Type>::value>
+{
+};
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for std::variant, that is serialized as a single
+ * byte index, followed by the largest alternative.
+ */
+template <typename... Types>
+struct max_serialized_size<std::variant<Types...>>
+    : std::integral_constant<
+          std::size_t,
+          sizeof(unsigned char) +
+              std::max({std::size_t{}, max_serialized_size<Types>::value...})>
+{
+};
+#endif
+
+/**
+ * The maximum serialized size of a type.
+ * This overload is for class types with serialize method, which must
+ * be constexpr and make a single archive call, such that the size is
+ * proven by the result of that call alone.
+ */
+template <typename Type>
+struct max_serialized_size<
+    Type,
+    void_t<decltype(Type::serialize(std::declval<max_size_archive &>(),
+                                    std::declval<Type &>()))>>
+    : max_serialized_size_of_result<decltype(Type::serialize(
+          std::declval<max_size_archive &>(), std::declval<Type &>()))>
+{
+    static_assert(size_archive_calls<Type, max_serialized_size>() == 1,
+                  "The serialize method must make a single archive call "
+                  "for a compile time maximum serialized size.");
+};
+
+/**
+ * The serialized size of a type whose every object is serialized in the
+ * same number of bytes, or zero if not known to be fixed.
+ */
+template <typename Type, typename>
+struct fixed_serialized_size : std::integral_constant<std::size_t, 0>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for fundamental and enumeration types.
+ */
+template <typename Type>
+struct fixed_serialized_size<
+    Type,
+    std::enable_if_t<std::is_fundamental<Type>::value ||
+                     std::is_enum<Type>::value>>
+    : std::integral_constant<std::size_t, sizeof(Type)>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for arrays.
+ */
+template <typename Type, std::size_t Size>
+struct fixed_serialized_size<Type[Size]>
+    : std::integral_constant<std::size_t,
+                             fixed_serialized_size<Type>::value * Size>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for std::array.
+ */
+template <typename Type, std::size_t Size>
+struct fixed_serialized_size<std::array<Type, Size>>
+    : fixed_serialized_size<Type[Size]>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for std::pair.
+ */
+template <typename First, typename Second>
+struct fixed_serialized_size<std::pair<First, Second>>
+    : fixed_serialized_size<std::tuple<First, Second>>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for std::tuple, whose size is fixed if the size of
+ * every element is.
+ */
+template <typename... Types>
+struct fixed_serialized_size<std::tuple<Types...>>
+    : std::integral_constant<
+          std::size_t,
+          all_of<0 != fixed_serialized_size<
+                          std::remove_const_t<Types>>::value...>::value
+              ? sum<fixed_serialized_size<
+                    std::remove_const_t<Types>>::value...>::value
+              : 0>
+{
+};
+
+/**
+ * The fixed serialized size from the result of a serialize method, or
+ * zero if it is not an integral constant.
+ */
+template <typename Result>
+struct fixed_serialized_size_of_result
+    : std::integral_constant<std::size_t, 0>
+{
+};
+
+/**
+ * The fixed serialized size from the result of a serialize method.
+ * This overload is for integral constant results.
+ */
+template <std::size_t Size>
+struct fixed_serialized_size_of_result<
+    std::integral_constant<std::size_t, Size>>
+    : std::integral_constant<std::size_t, Size>
+{
+};
+
+/**
+ * The fixed serialized size of a class type, whose serialize method
+ * must be constexpr and make a single archive call.
+ */
+template <typename Type, typename = void>
+struct fixed_serialized_size_of_class
+    : std::integral_constant<std::size_t, 0>
+{
+};
+
+/**
+ * The fixed serialized size of a class type.
+ * This overload is for classes whose serialize method makes a single
+ * archive call, in a constant expression.
+ */
+template <typename Type>
+struct fixed_serialized_size_of_class<
+    Type,
+    std::enable_if_t<1 ==
+                     size_archive_calls<Type, fixed_serialized_size>()>>
+    : fixed_serialized_size_of_result<decltype(Type::serialize(
+          std::declval<size_archive<fixed_serialized_size> &>(),
+          std::declval<Type &>()))>
+{
+};
+
+/**
+ * The fixed serialized size of a type.
+ * This overload is for default constructible class types with serialize
+ * method.
+ */
+template <typename Type>
+struct fixed_serialized_size<
+    Type,
+    std::enable_if_t<std::is_class<Type>::value &&
+                         std::is_default_constructible<Type>::value,
+                     void_t<decltype(Type::serialize(
+                         std::declval<size_archive<fixed_serialized_size> &>(),
+                         std::declval<Type &>()))>>>
+    : fixed_serialized_size_of_class<Type>
+{
+};
+} // namespace detail
+
+/**
+ * The maximum serialized size of a type, known at compile time, for
+ * types of fixed maximum size: fundamental and enumeration types, fixed
+ * arrays, std::pair, std::tuple, std::optional and std::variant of such
+ * types, and classes of such types whose constexpr serialize method
+ * makes a single archive call and returns its result.
+ * Example:
+ * ~~~
+ * std::array<unsigned char, zpp::serializer::max_size_v<message>> buffer;
+ * zpp::serializer::memory_view_output_archive out(buffer);
+ * out(message);
+ * ~~~
+ */
+template <typename Type>
+struct max_size
+    : std::integral_constant<std::size_t,
+                             detail::max_serialized_size<Type>::value>
+{
+};
+
+/**
+ * The maximum serialized size of a type, known at compile time.
+ */
+template <typename Type>
+constexpr std::size_t max_size_v = max_size<Type>::value;
+
+/**
+ * This archive serves as an input archive, that loads trusted data from
+ * a view, without checking the bounds of every load, such as data that
+ * was saved by the program itself, and verified since, for example by a
+ * checksum. Loading data that is not well formed is undefined behavior.
+ * The length of the input may be checked once up front with fits(), for
+ * items of fixed maximum size. The remaining input is not exposed, so
+ * container sizes are not checked against it either.
+ */
+class trusted_memory_view_input_archive
+    : public archive<trusted_memory_view_input_archive>
+{
+public:
+    /**
+     * The base archive.
+     */
+    using base = archive<trusted_memory_view_input_archive>;
+
+    /**
+     * Declare base as friend.
+     */
+    friend base;
+
+    /**
+     * Loading archive.
+     */
+    using loading = void;
+
+    /**
+     * Constructs a trusted memory view input archive, that loads data
+     * from an array of given pointer and size.
+     */
+    trusted_memory_view_input_archive(const unsigned char * input,
+                                      std::size_t size) noexcept :
+        m_input(input),
+        m_size(size)
+    {
+    }
+
+    /**
+     * Constructs a trusted memory view input archive, that loads data
+     * from the given vector.
+     */
+    explicit trusted_memory_view_input_archive(
+        const std::vector<unsigned char> & input) noexcept :
+        trusted_memory_view_input_archive(input.data(), input.size())
+    {
+    }
+
+    /**
+     * Returns true if the input past the offset holds the maximum
+     * serialized size of the given items, which are then safe to load.
+     * Items whose maximum size is not proven by max_size, such as
+     * classes whose serialize method makes more than one archive call,
+     * do not compile.
+     */
+    template <typename... Items>
+    bool fits() const noexcept
+    {
+        return detail::sum<max_size<Items>::value...>::value <=
+               m_size - m_offset;
+    }
+
+    /**
+     * Returns the input data.
+     */
+    const unsigned char * data() const noexcept
+    {
+        return m_input;
+    }
+
+    /**
+     * Returns the current offset in the input data.
+     */
+    std::size_t offset() const noexcept
+    {
+        return m_offset;
+    }
+
+    /**
+     * Resets the serialization to offset, to allow advanced use.
+     */
+    void reset(std::size_t offset = {}) noexcept
+    {
+        m_offset = offset;
+    }
+
+protected:
+    /**
+     * Serialize a single item - load it from the input, unchecked.
+     */
+    template <typename Item>
+    auto serialize(Item && item)
+    {
+        std::memcpy(std::addressof(item), m_input + m_offset, sizeof(item));
+        m_offset += sizeof(item);
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+    /**
+     * Serializes bytes data - load it from the input, unchecked.
+     */
+    auto serialize(void * data, std::size_t size)
+    {
+        std::memcpy(data, m_input + m_offset, size);
+        m_offset += size;
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+private:
+    /**
+     * The input data.
+     */
+    const unsigned char * m_input{};
+
+    /**
+     * The input size.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The next input.
+     */
+    std::size_t m_offset{};
+};
+
+#if __cplusplus >= 202002L
+namespace detail
+{
+/**
+ * An output archive that serializes into a fixed size array during
+ * constant evaluation. Serializes types of compile time maximum size,
+ * in the same format as the memory output archives.
+ */
+template <std::size_t Size>
+class constexpr_output_archive
+{
+public:
+    /**
+     * Saving archive.
+     */
+    using saving = void;
+
+    /**
+     * Constructs a constexpr output archive, that outputs to the given
+     * array.
+     */
+    constexpr explicit constexpr_output_archive(
+        std::array<unsigned char, Size> & output) noexcept :
+        m_output(output)
+    {
+    }
+
+    /**
+     * Serializes the given items.
+     */
+    template <typename... Items>
+    constexpr void operator()(Items &&... items)
+    {
+        (serialize_item(items), ...);
+    }
+
+    /**
+     * Returns the offset of the archive.
+     */
+    constexpr std::size_t offset() const noexcept
+    {
+        return m_offset;
+    }
+
+private:
+    /**
+     * Serialize a single item.
+     */
+    template <typename Item>
+    constexpr void serialize_item(const Item & item)
+    {
+        if constexpr (std::is_fundamental_v<Item> || std::is_enum_v<Item>) {
+            // Convert to the object representation, as with memcpy.
+            auto bytes =
+                std::bit_cast<std::array<unsigned char, sizeof(Item)>>(item);
+            for (auto byte : bytes) {
+                m_output[m_offset++] = byte;
+            }
+        } else if constexpr (std::is_array_v<Item>) {
+            for (auto & element : item) {
+                serialize_item(element);
+            }
+        } else if constexpr (requires { std::tuple_size<Item>::value; }) {
+            std::apply(
+                [&](auto &... elements) { (serialize_item(elements), ...); },
+                item);
+        } else {
+            Item::serialize(*this, item);
+        }
+    }
+
+    /**
+     * Serialize a single item.
+     * This overload is for std::optional.
+     */
+    template <typename Item>
+    constexpr void serialize_item(const std::optional<Item> & item)
+    {
+        serialize_item(item.has_value());
+        if (item) {
+            serialize_item(*item);
+        }
+    }
+
+    /**
+     * Serialize a single item.
+     * This overload is for std::variant.
+     */
+    template <typename... Types>
+    constexpr void serialize_item(const std::variant<Types...> & item)
+    {
+        serialize_item(static_cast<unsigned char>(item.index()));
+        std::visit([&](auto & value) { serialize_item(value); }, item);
+    }
+
+    /**
+     * The output array.
+     */
+    std::array<unsigned char, Size> & m_output;
+
+    /**
+     * The offset in the output array.
+     */
+    std::size_t m_offset{};
+};
+} // namespace detail
+
+/**
+ * The bytes of an item serialized in a constant expression, held in an
+ * array of the maximum serialized size of the item, of which only the
+ * first size() bytes are used, and the rest are zero.
+ */
+template <std::size_t Capacity>
+class serialized_bytes
+{
+public:
+    /**
+     * Constructs the serialized bytes from the array and the number of
+     * bytes used.
+     */
+    constexpr serialized_bytes(
+        const std::array<unsigned char, Capacity> & bytes,
+        std::size_t size) noexcept :
+        m_bytes(bytes),
+        m_size(size)
+    {
+    }
+
+    /**
+     * Returns the serialized bytes.
+     */
+    constexpr const unsigned char * data() const noexcept
+    {
+        return m_bytes.data();
+    }
+
+    /**
+     * Returns the number of serialized bytes.
+     */
+    constexpr std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns the first serialized byte.
+     */
+    constexpr auto begin() const noexcept
+    {
+        return m_bytes.begin();
+    }
+
+    /**
+     * Returns past the last serialized byte.
+     */
+    constexpr auto end() const noexcept
+    {
+        return m_bytes.begin() + m_size;
+    }
+
+    /**
+     * Returns the serialized byte at the given index.
+     */
+    constexpr unsigned char operator[](std::size_t index) const noexcept
+    {
+        return m_bytes[index];
+    }
+
+private:
+    /**
+     * The serialized bytes, followed by zeros.
+     */
+    std::array<unsigned char, Capacity> m_bytes{};
+
+    /**
+     * The number of serialized bytes.
+     */
+    std::size_t m_size{};
+};
+
+/**
+ * Serializes an item of compile time maximum size, in constant
+ * expressions, into an array of max_size_v bytes, returned along with
+ * the number of bytes used. The serialize method of the item must be
+ * constexpr.
+ * Example:
+ * ~~~
+ * constexpr auto handshake_message =
+ *     zpp::serializer::to_bytes(handshake{protocol_version});
+ * send(handshake_message.data(), handshake_message.size());
+ * ~~~
+ */
+template <typename Item>
+constexpr auto to_bytes(const Item & item)
+{
+    std::array<unsigned char, max_size_v<Item>> output{};
+    detail::constexpr_output_archive<max_size_v<Item>> archive(output);
+    archive(item);
+    return serialized_bytes<max_size_v<Item>>(output, archive.offset());
+}
+#endif
+
+#if __cplusplus >= 201703L
+namespace detail
+{
+/**
+ * Serialize the value of an extracted node of a map.
+ */
+template <typename Archive,
+          typename Node,
+          typename...,
+          typename = decltype(std::declval<Node &>().mapped())>
+auto serialize_node(Archive & archive, Node & node)
+{
+    // Serialize key, then mapped value, as a pair.
+    return archive(node.key(), node.mapped());
+}
+
+/**
+ * Serialize the value of an extracted node of a set.
+ */
+template <typename Archive,
+          typename Node,
+          typename...,
+          typename = decltype(std::declval<Node &>().value()),
+          typename = void>
+auto serialize_node(Archive & archive, Node & node)
+{
+    return archive(node.value());
+}
+} // namespace detail
+
+/**
+ * Represents a container whose contents are replaced when loaded, while
+ * reusing its existing nodes, so that reloading a node based container
+ * of the same size allocates no nodes.
+ * Maps and sets extract their existing nodes and refill them, lists
+ * refill their existing nodes in place, and other containers are
+ * serialized as usual. The serialized form is the same as of the
+ * container itself.
+ */
+template <typename Container>
+class node_reusing_container
+{
+public:
+    /**
+     * Must be class type.
+     */
+    static_assert(std::is_class<Container>::value,
+                  "Container must be a class type.");
+
+    /**
+     * Construct the node reusing container.
+     */
+    explicit node_reusing_container(Container & container) :
+        container(container)
+    {
+    }
+
+    /**
+     * Serialize the node reusing container.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_container(archive, self.container);
+    }
+
+    /**
+     * The wrapped container.
+     */
+    Container & container;
+
+private:
+    /**
+     * Serialize the container, in case of a loading (input) archive and
+     * a node based associative container.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Items::node_type,
+              typename = typename Archive::loading>
+    static auto serialize_container(Archive & archive, Items & container)
+    {
+        size_type size{};
+
+        // Fetch the number of items to load.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        archive(size);
+#else
+        if (auto result = archive(size); !result) {
+            return result;
+        }
+#endif
+
+        // Verify the size against the remaining input and allocation
+        // budget.
+        using item_type = detail::container_nonconst_value_type_t<Items>;
+#ifndef ZPP_SERIALIZER_FREESTANDING
+        detail::verify_load_size(
+            archive,
+            size,
+            detail::min_serialized_size<item_type>::value,
+            sizeof(item_type));
+#else
+        if (auto result = detail::verify_load_size(
+                archive,
+                size,
+                detail::min_serialized_size<item_type>::value,
+                sizeof(item_type));
+            !result) {
+            return result;
+        }
+#endif
+
+        // Move the existing nodes aside, to be extracted and refilled.
+        Items nodes(std::move(container));
+        container.clear();
+        detail::reserve_if_reservable(
+            container,
+            std::min<std::size_t>(size, detail::remaining_of(archive, 0)),
+            0);
+
+        // Serialize all the items.
+        for (size_type i{}; i < size; ++i) {
+            // Reuse an existing node if there is one left.
+            if (!nodes.empty()) {
+                auto node = nodes.extract(nodes.begin());
+#ifndef ZPP_SERIALIZER_FREESTANDING
+                detail::serialize_node(archive, node);
+#else
+                if (auto result = detail::serialize_node(archive, node);
+                    !result) {
+                    return result;
+                }
+#endif
+                container.insert(container.end(), std::move(node));
+                continue;
+            }
+
+            // Create just enough storage properly aligned for one item.
+            std::aligned_storage_t<sizeof(item_type), alignof(item_type)>
+                storage;
+
+            // Create the object at the storage.
+            std::unique_ptr<item_type, void (*)(item_type *)> object(
+                access::placement_new<item_type>(std::addressof(storage)),
+                [](auto pointer) { access::destruct(*pointer); });
+
+            // Serialize the object.
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            archive(*object);
+#else
+            if (auto result = archive(*object); !result) {
+                return result;
+            }
+#endif
+
+            // Insert the item to the container.
+            container.insert(container.end(), std::move(*object));
+        }
+
+#ifdef ZPP_SERIALIZER_FREESTANDING
+        return freestanding::error{error::success};
+#endif
+    }
+
+    /**
+     * Serialize the container, in case of a loading (input) archive and
+     * any other container, that is resized and refilled in place.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = std::enable_if_t<
+                  !detail::is_node_container<Items>::value>,
+              typename = typename Archive::loading,
+              typename = void>
+    static auto serialize_container(Archive & archive, Items & container)
+    {
+        return archive(container);
+    }
+
+    /**
+     * Serialize the container, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void,
+              typename = void>
+    static auto serialize_container(Archive & archive,
+                                    const Items & container)
+    {
+        return archive(container);
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Serialize the container, in case of a skipping archive, that skips
+     * it without touching its nodes.
+     */
+    template <typename Items>
+    static void serialize_container(skipping_archive & archive,
+                                    Items & container)
+    {
+        archive(container);
+    }
+#endif
+};
+
+/**
+ * Creates a wrapper object of node_reusing_container to allow loading
+ * a container that replaces its contents while reusing its nodes.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::reuse_nodes(self.m_lookup_table));
+ * ~~~
+ */
+template <typename Container>
+auto reuse_nodes(Container && container)
+{
+    return node_reusing_container<std::remove_reference_t<Container>>(
+        container);
+}
+#endif
+
+/**
+ * Represents a sequence of bit fields that are packed together.
+ */
+template <typename... BitFields>
+class bit_fields;
+
+/**
+ * Represents an integral, boolean or enumeration item that is serialized
+ * using only a specific number of bits.
+ * The value of the item must be non negative and fit in the bit count.
+ */
+template <std::size_t Count, typename Item>
+class bit_field
+{
+public:
+    /**
+     * Must be integral, boolean or enumeration type.
+     */
+    static_assert(std::is_integral<Item>::value ||
+                      std::is_enum<Item>::value,
+                  "Item must be an integral or enumeration type.");
+
+    /**
+     * Must be at least one bit and at most 64 bits.
+     */
+    static_assert(Count > 0 && Count <= 64,
+                  "Bit count must be between 1 and 64.");
+
+    /**
+     * The bit count.
+     */
+    static constexpr std::size_t count = Count;
+
+    /**
+     * Construct the bit field.
+     */
+    explicit bit_field(Item & item) : item(item)
+    {
+    }
+
+    /**
+     * Serialize the bit field as the only field in a bit pack.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return archive(bit_fields<bit_field>(self));
+    }
+
+    /**
+     * Returns the item value as bits.
+     */
+    std::uint64_t to_bits() const noexcept
+    {
+        auto value = static_cast<std::uint64_t>(
+            static_cast<detail::bit_field_integral_t<Item>>(item));
+        return value & (~std::uint64_t{} >> (64 - Count));
+    }
+
+    /**
+     * Sets the item value from bits.
+     */
+    void from_bits(std::uint64_t bits) noexcept
+    {
+        item = static_cast<Item>(
+            static_cast<detail::bit_field_integral_t<Item>>(bits));
+    }
+
+    /**
+     * The wrapped item.
+     */
+    Item & item;
+};
+
+/**
+ * Represents a sequence of bit fields that are packed together
+ * into the least number of bytes, least significant bit first.
+ */
+template <typename... BitFields>
+class bit_fields
 {
-    // Serialize every item.
-    for (auto & item : array) {
+public:
+    /**
+     * The total bit count.
+     */
+    static constexpr std::size_t count =
+        detail::sum<BitFields::count...>::value;
+
+    /**
+     * Must be at most 64 bits.
+     */
+    static_assert(count <= 64, "Bit pack must be at most 64 bits.");
+
+    /**
+     * Construct the bit pack.
+     */
+    explicit bit_fields(const BitFields &... fields) : fields(fields...)
+    {
+    }
+
+    /**
+     * Serialize the packed bit fields.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize(
+            archive, self, std::index_sequence_for<BitFields...>());
+    }
+
+    /**
+     * The wrapped bit fields.
+     */
+    std::tuple<BitFields...> fields;
+
+private:
+    /**
+     * Serialize the packed bit fields, in case of a loading (input)
+     * archive.
+     */
+    template <typename Archive,
+              typename Self,
+              std::size_t... Indices,
+              typename...,
+              typename = typename Archive::loading>
+    static auto serialize(Archive & archive,
+                          Self & self,
+                          std::index_sequence<Indices...>)
+    {
+        unsigned char bytes[(count + 7) / 8]{};
+
+        // Load the packed bytes.
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
+        archive(as_bytes(bytes, sizeof(bytes)));
 #else
-        if (auto result = archive(item); !result) {
+        if (auto result = archive(as_bytes(bytes, sizeof(bytes)));
+            !result) {
             return result;
         }
 #endif
-    }
+
+        // Assemble the bits.
+        std::uint64_t bits{};
+        for (std::size_t i{}; i < sizeof(bytes); ++i) {
+            bits |= std::uint64_t(bytes[i]) << (i * 8);
+        }
+
+        // Unpack the fields one by one.
+        std::size_t shift{};
+        (void)std::initializer_list<int>{
+            (std::get<Indices>(self.fields).from_bits(
+                 (bits >> shift) &
+                 (~std::uint64_t{} >> (64 - BitFields::count))),
+             shift += BitFields::count,
+             0)...};
 
 #ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
+        return freestanding::error{error::success};
+#endif
+    }
+
+    /**
+     * Serialize the packed bit fields, in case of a saving (output)
+     * archive.
+     */
+    template <typename Archive,
+              typename Self,
+              std::size_t... Indices,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static auto serialize(Archive & archive,
+                          Self & self,
+                          std::index_sequence<Indices...>)
+    {
+        // Pack the fields one by one.
+        std::uint64_t bits{};
+        std::size_t shift{};
+        (void)std::initializer_list<int>{
+            (bits |= std::get<Indices>(self.fields).to_bits() << shift,
+             shift += BitFields::count,
+             0)...};
+
+        // Split the bits to bytes.
+        unsigned char bytes[(count + 7) / 8]{};
+        for (std::size_t i{}; i < sizeof(bytes); ++i) {
+            bytes[i] = static_cast<unsigned char>(bits >> (i * 8));
+        }
+
+        // Save the packed bytes.
+        return archive(as_bytes(bytes, sizeof(bytes)));
+    }
+
+#ifndef ZPP_SERIALIZER_FREESTANDING
+    /**
+     * Serialize the packed bit fields, in case of a skipping archive.
+     * The packed bytes are skipped, and the fields are left untouched.
+     */
+    template <typename Self, std::size_t... Indices>
+    static void serialize(skipping_archive & archive,
+                          Self &,
+                          std::index_sequence<Indices...>)
+    {
+        archive.advance((count + 7) / 8);
+    }
 #endif
+};
+
+/**
+ * Creates a wrapper object of bit_field to allow serialization
+ * of an integral or enumeration item using only 'Count' bits.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::bits<3>(self.m_color));
+ * ~~~
+ */
+template <std::size_t Count, typename Item>
+auto bits(Item && item)
+{
+    return bit_field<Count, std::remove_reference_t<Item>>(item);
 }
 
 /**
- * Serialize arrays, operates on loading (input) archives.
- * This overload is for fundamental or enumeration types.
+ * Creates a wrapper object of bit_fields to allow packing multiple
+ * bit fields together into the least number of bytes.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::pack_bits(zpp::serializer::bits<3>(self.m_color),
+ *                                    zpp::serializer::bits<5>(self.m_flags)));
+ * ~~~
  */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
-                                      std::is_enum<Item>::value>,
-          typename = typename Archive::loading,
-          typename = void>
-auto serialize(Archive & archive, Item (&array)[size])
+template <typename... BitFields>
+auto pack_bits(const BitFields &... fields)
 {
-    return archive(as_bytes(array, size));
+    return bit_fields<BitFields...>(fields...);
+}
+
+namespace detail
+{
+/**
+ * Returns the number of leading zero bits of a non zero value.
+ */
+inline std::size_t count_leading_zeros(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_clzll(value));
+#else
+    std::size_t count{};
+    for (std::size_t shift = 32; shift; shift /= 2) {
+        if (!(value >> (64 - shift))) {
+            value <<= shift;
+            count += shift;
+        }
+    }
+    return count;
+#endif
+}
+
+/**
+ * Returns the number of trailing zero bits of a non zero value.
+ */
+inline std::size_t count_trailing_zeros(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(value));
+#else
+    std::size_t count{};
+    for (std::size_t shift = 32; shift; shift /= 2) {
+        if (!(value << (64 - shift))) {
+            value >>= shift;
+            count += shift;
+        }
+    }
+    return count;
+#endif
 }
 
 /**
- * Serialize arrays, operates on saving (output) archives.
- * This overload is for non fundamental non enumeration types.
+ * Counts the bits written by the floating point encoder, without
+ * writing them.
+ */
+class bit_counter
+{
+public:
+    /**
+     * Counts 'count' bits.
+     */
+    void write(std::uint64_t, std::size_t count) noexcept
+    {
+        m_count += count;
+    }
+
+    /**
+     * Returns the number of bits counted.
+     */
+    std::size_t count() const noexcept
+    {
+        return m_count;
+    }
+
+private:
+    /**
+     * The number of bits counted.
+     */
+    std::size_t m_count{};
+};
+
+/**
+ * Writes bits into a byte buffer, least significant bit first.
+ * The buffer is meant to be flushed once its size reaches flush_size.
+ */
+class bit_writer
+{
+public:
+    /**
+     * The size at which the buffer should be flushed.
+     */
+    static constexpr std::size_t flush_size = 256;
+
+    /**
+     * Writes the lowest 'count' bits of value, the rest must be zero.
+     */
+    void write(std::uint64_t value, std::size_t count) noexcept
+    {
+        if (!count) {
+            return;
+        }
+
+        // Append the bits to the pending bits.
+        m_bits |= value << m_count;
+        auto total = m_count + count;
+        if (total < 64) {
+            m_count = total;
+            return;
+        }
+
+        // Store a full word, and keep the bits that did not fit.
+        for (std::size_t i{}; i < sizeof(m_bits); ++i) {
+            m_buffer[m_size++] = static_cast<unsigned char>(m_bits >> (i * 8));
+        }
+        m_count = total - 64;
+        m_bits = m_count ? value >> (count - m_count) : 0;
+    }
+
+    /**
+     * Stores the pending bits, padded with zeros to a whole byte.
+     */
+    void finish() noexcept
+    {
+        for (std::size_t i{}; i < (m_count + 7) / 8; ++i) {
+            m_buffer[m_size++] = static_cast<unsigned char>(m_bits >> (i * 8));
+        }
+        m_bits = {};
+        m_count = {};
+    }
+
+    /**
+     * Returns the buffered bytes.
+     */
+    const unsigned char * data() const noexcept
+    {
+        return m_buffer;
+    }
+
+    /**
+     * Returns the number of buffered bytes.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Empties the buffer, after it was flushed.
+     */
+    void clear() noexcept
+    {
+        m_size = {};
+    }
+
+private:
+    /**
+     * The buffered bytes.
+     */
+    unsigned char m_buffer[flush_size * 2];
+
+    /**
+     * The number of buffered bytes.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The pending bits.
+     */
+    std::uint64_t m_bits{};
+
+    /**
+     * The number of pending bits, always less than 64.
+     */
+    std::size_t m_count{};
+};
+
+/**
+ * Reads bits from a byte buffer, least significant bit first.
+ * The buffer is meant to be refilled once fewer than refill_size bytes
+ * are available.
+ */
+class bit_reader
+{
+public:
+    /**
+     * The number of available bytes under which the buffer should be
+     * refilled.
+     */
+    static constexpr std::size_t refill_size = 16;
+
+    /**
+     * The buffer capacity.
+     */
+    static constexpr std::size_t capacity = 512;
+
+    /**
+     * Reads 'count' bits. Reading past the available bytes returns zero
+     * bits and marks the reader as overrun.
+     */
+    std::uint64_t read(std::size_t count) noexcept
+    {
+        if (count > 32) {
+            auto low = read(32);
+            return low | (read(count - 32) << 32);
+        }
+
+        // Fill the pending bits if needed.
+        if (m_count < count) {
+            while (m_count <= 56 && m_position < m_size) {
+                m_bits |= std::uint64_t(m_buffer[m_position++]) << m_count;
+                m_count += 8;
+            }
+            if (m_count < count) {
+                m_overrun = true;
+                m_count = count;
+            }
+        }
+
+        // Extract the bits.
+        auto value = m_bits & ~(~std::uint64_t{} << count);
+        m_bits >>= count;
+        m_count -= count;
+        return value;
+    }
+
+    /**
+     * Returns the number of bytes available in the buffer.
+     */
+    std::size_t available() const noexcept
+    {
+        return m_size - m_position;
+    }
+
+    /**
+     * Moves the available bytes to the beginning of the buffer and
+     * returns where up to capacity minus available bytes may be added.
+     */
+    unsigned char * prepare() noexcept
+    {
+        std::copy(m_buffer + m_position, m_buffer + m_size, m_buffer);
+        m_size -= m_position;
+        m_position = {};
+        return m_buffer + m_size;
+    }
+
+    /**
+     * Commits 'count' bytes added after prepare().
+     */
+    void commit(std::size_t count) noexcept
+    {
+        m_size += count;
+    }
+
+    /**
+     * Returns true if read past the available bytes, else false.
+     */
+    bool overrun() const noexcept
+    {
+        return m_overrun;
+    }
+
+private:
+    /**
+     * The buffered bytes.
+     */
+    unsigned char m_buffer[capacity];
+
+    /**
+     * The number of buffered bytes.
+     */
+    std::size_t m_size{};
+
+    /**
+     * The position of the next byte to read.
+     */
+    std::size_t m_position{};
+
+    /**
+     * The pending bits.
+     */
+    std::uint64_t m_bits{};
+
+    /**
+     * The number of pending bits.
+     */
+    std::size_t m_count{};
+
+    /**
+     * Whether read past the available bytes.
+     */
+    bool m_overrun{};
+};
+
+/**
+ * Encodes and decodes a sequence of floating point values, given by their
+ * bits, using the exclusive or with the previous value.
+ * The first value is stored in full. Then, a zero bit is stored if equal
+ * to the previous value. Else, the bits '10' are stored if the meaningful
+ * bits of the exclusive or fit within the previous leading and trailing
+ * zeros, followed by the meaningful bits. Else, the bits '11', 5 bits of
+ * leading zeros, the meaningful bit count minus one, and the meaningful
+ * bits.
  */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
-                                      !std::is_enum<Item>::value>,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const Item (&array)[size])
+template <typename Bits>
+class float_codec
 {
-    // Serialize every item.
-    for (auto & item : array) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
+public:
+    /**
+     * The width of the values in bits.
+     */
+    static constexpr std::size_t width = sizeof(Bits) * 8;
+
+    /**
+     * The width of the meaningful bit count.
+     */
+    static constexpr std::size_t length_width = width == 64 ? 6 : 5;
+
+    /**
+     * Encodes the given value into the given bit writer or counter.
+     */
+    template <typename Writer>
+    void encode(Bits value, Writer & writer) noexcept
+    {
+        // The first value is stored in full.
+        if (m_first) {
+            m_first = false;
+            m_previous = value;
+            writer.write(value, width);
+            return;
         }
-#endif
-    }
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+        // The exclusive or with the previous value.
+        auto difference = value ^ m_previous;
+        m_previous = value;
 
-/**
- * Serialize arrays, operates on saving (output) archives.
- * This overload is for fundamental or enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
-                                      std::is_enum<Item>::value>,
-          typename = typename Archive::saving,
-    typename = void>
-auto serialize(Archive & archive, const Item (&array)[size])
-{
-    return archive(as_bytes(array, size));
-}
+        // Equal to the previous value.
+        if (!difference) {
+            writer.write(0, 1);
+            return;
+        }
 
-/**
- * Serialize std::array, operates on loading (input) archives.
- * This overload is for non fundamental non enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
-                                      !std::is_enum<Item>::value>,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::array<Item, size> & array)
-{
-    // Serialize every item.
-    for (auto & item : array) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
+        // Count the leading and trailing zeros.
+        auto leading = std::min<std::size_t>(
+            count_leading_zeros(difference) - (64 - width), 31);
+        auto trailing = count_trailing_zeros(difference);
+
+        // Fits within the previous leading and trailing zeros.
+        if (m_window && leading >= m_leading && trailing >= m_trailing) {
+            writer.write(0x1, 2);
+            writer.write(difference >> m_trailing,
+                         width - m_leading - m_trailing);
+            return;
         }
-#endif
+
+        // Store the new leading and meaningful bit count.
+        m_window = true;
+        m_leading = leading;
+        m_trailing = trailing;
+        auto meaningful = width - leading - trailing;
+        writer.write(0x3, 2);
+        writer.write(leading, 5);
+        writer.write(meaningful - 1, length_width);
+        writer.write(difference >> trailing, meaningful);
     }
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+    /**
+     * Decodes the next value from the given bit reader.
+     * Returns false if the encoding is invalid, else true.
+     */
+    bool decode(bit_reader & reader, Bits & value) noexcept
+    {
+        // The first value is stored in full.
+        if (m_first) {
+            m_first = false;
+            m_previous = static_cast<Bits>(reader.read(width));
+            value = m_previous;
+            return true;
+        }
 
-/**
- * Serialize std::array, operates on loading (input) archives.
- * This overload is for fundamental or enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
-                                      std::is_enum<Item>::value>,
-          typename = typename Archive::loading,
-          typename = void>
-auto serialize(Archive & archive, std::array<Item, size> & array)
-{
-    return archive(as_bytes(std::addressof(array[0]), size));
-}
+        // Equal to the previous value.
+        if (!reader.read(1)) {
+            value = m_previous;
+            return true;
+        }
 
-/**
- * Serialize std::array, operates on saving (output) archives.
- * This overload is for non fundamental non enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<!std::is_fundamental<Item>::value &&
-                                      !std::is_enum<Item>::value>,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::array<Item, size> & array)
-{
-    // Serialize every item.
-    for (auto & item : array) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(item);
-#else
-        if (auto result = archive(item); !result) {
-            return result;
+        // Read new leading and meaningful bit count if needed.
+        if (reader.read(1)) {
+            m_leading = static_cast<std::size_t>(reader.read(5));
+            auto meaningful =
+                static_cast<std::size_t>(reader.read(length_width)) + 1;
+            if (m_leading + meaningful > width) {
+                return false;
+            }
+            m_trailing = width - m_leading - meaningful;
+            m_window = true;
+        } else if (!m_window) {
+            return false;
         }
-#endif
+
+        // Read the meaningful bits and apply the exclusive or.
+        m_previous ^= static_cast<Bits>(
+            reader.read(width - m_leading - m_trailing) << m_trailing);
+        value = m_previous;
+        return true;
     }
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+private:
+    /**
+     * The previous value.
+     */
+    Bits m_previous{};
 
-/**
- * Serialize std::array, operates on saving (output) archives.
- * This overload is for fundamental or enumeration types.
- */
-template <typename Archive,
-          typename Item,
-          std::size_t size,
-          typename...,
-          typename = std::enable_if_t<std::is_fundamental<Item>::value ||
-                                      std::is_enum<Item>::value>,
-          typename = typename Archive::saving,
-          typename = void>
-auto serialize(Archive & archive, const std::array<Item, size> & array)
-{
-    return archive(as_bytes(std::addressof(array[0]), size));
-}
+    /**
+     * The leading zeros of the current window.
+     */
+    std::size_t m_leading{};
 
-/**
- * Serialize std::pair, operates on loading (input) archives.
- */
-template <typename Archive,
-          typename First,
-          typename Second,
-          typename...,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::pair<First, Second> & pair)
-{
-    // Serialize first, then second.
-    return archive(pair.first, pair.second);
-}
+    /**
+     * The trailing zeros of the current window.
+     */
+    std::size_t m_trailing{};
 
-/**
- * Serialize std::pair, operates on saving (output) archives.
- */
-template <typename Archive,
-          typename First,
-          typename Second,
-          typename...,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::pair<First, Second> & pair)
-{
-    // Serialize first, then second.
-    return archive(pair.first, pair.second);
-}
+    /**
+     * Whether this is the first value.
+     */
+    bool m_first = true;
 
-/**
- * Serialize std::tuple, operates on loading (input) archives.
- */
-template <typename Archive,
-          typename... TupleItems,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::tuple<TupleItems...> & tuple)
-{
-    // Delegate to a helper function with an index sequence.
-    return serialize(
-        archive, tuple, std::make_index_sequence<sizeof...(TupleItems)>());
-}
+    /**
+     * Whether there is a current window.
+     */
+    bool m_window{};
+};
+} // namespace detail
 
 /**
- * Serialize std::tuple, operates on saving (output) archives.
+ * Represents a container of floating point values that is serialized
+ * compressed, using the exclusive or of every value with the previous
+ * one, which suits slowly changing series. The compression is lossless.
+ * The container size and the compressed size in bytes are serialized
+ * first, followed by the compressed bits.
  */
-template <typename Archive,
-          typename... TupleItems,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::tuple<TupleItems...> & tuple)
+template <typename Container>
+class float_compressed_container
 {
-    // Delegate to a helper function with an index sequence.
-    return serialize(
-        archive, tuple, std::make_index_sequence<sizeof...(TupleItems)>());
-}
+public:
+    /**
+     * The value type of the container.
+     */
+    using value_type = std::remove_const_t<typename Container::value_type>;
 
-/**
- * Serialize std::tuple, operates on loading (input) archives.
- * This overload serves as a helper function that accepts an index
- * sequence.
- */
-template <typename Archive,
-          typename... TupleItems,
-          std::size_t... Indices,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive,
-               std::tuple<TupleItems...> & tuple,
-               std::index_sequence<Indices...>)
-{
-    return archive(std::get<Indices>(tuple)...);
-}
+    /**
+     * Must be float or double.
+     */
+    static_assert(std::is_floating_point<value_type>::value &&
+                      (sizeof(value_type) == sizeof(std::uint32_t) ||
+                       sizeof(value_type) == sizeof(std::uint64_t)),
+                  "Container must be of 32 or 64 bit floating point.");
 
-/**
- * Serialize std::tuple, operates on saving (output) archives.
- * This overload serves as a helper function that accepts an index
- * sequence.
- */
-template <typename Archive,
-          typename... TupleItems,
-          std::size_t... Indices,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive,
-               const std::tuple<TupleItems...> & tuple,
-               std::index_sequence<Indices...>)
-{
-    return archive(std::get<Indices>(tuple)...);
-}
+    /**
+     * The bits type of the values.
+     */
+    using bits_type =
+        std::conditional_t<sizeof(value_type) == sizeof(std::uint32_t),
+                           std::uint32_t,
+                           std::uint64_t>;
+
+    /**
+     * Construct the compressed container.
+     */
+    explicit float_compressed_container(Container & container) :
+        container(container)
+    {
+    }
+
+    /**
+     * Serialize the compressed container.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_container(archive, self.container);
+    }
+
+    /**
+     * The wrapped container.
+     */
+    Container & container;
+
+private:
+    /**
+     * Serialize the compressed container, in case of a loading (input)
+     * archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::loading>
+    static auto serialize_container(Archive & archive, Items & container)
+    {
+        size_type size{};
+        size_type compressed_size{};
 
-#if __cplusplus >= 201703L
-/**
- * Serialize std::optional, operates on loading (input) archives.
- */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::optional<Type> & optional)
-{
-    // Load whether has value.
-    bool has_value{};
+        // Fetch the number of values and the compressed size.
 #ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(has_value);
+        archive(size, compressed_size);
 #else
-    if (auto result = archive(has_value); !result) {
-        return result;
-    }
+        if (auto result = archive(size, compressed_size); !result) {
+            return result;
+        }
 #endif
 
-    // If does not have a value.
-    if (!has_value) {
-        optional = std::nullopt;
+        // Every value but the first takes at least one bit.
+        if (size && std::uint64_t(compressed_size) * 8 <
+                        sizeof(bits_type) * 8 + (size - 1)) {
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        return;
+            throw out_of_range("Compressed floating point data is too small.");
 #else
-        return freestanding::error{error::success};
+            return freestanding::error{error::out_of_range};
 #endif
-    }
-
-    // If the type is default constructible.
-    if constexpr (std::is_default_constructible_v<Type>) {
-        // Create the value if does not exist.
-        if (!optional) {
-            optional = Type{};
         }
 
-        // Load the value.
+        // Verify the compressed size against the remaining input, and
+        // the size against the allocation budget.
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(*optional);
+        detail::verify_load_size(archive, compressed_size, 1, 0);
+        detail::verify_load_size(archive, size, 0, sizeof(value_type));
 #else
-        if (auto result = archive(*optional); !result) {
+        if (auto result =
+                detail::verify_load_size(archive, compressed_size, 1, 0);
+            !result) {
+            return result;
+        }
+        if (auto result =
+                detail::verify_load_size(archive, size, 0, sizeof(value_type));
+            !result) {
             return result;
         }
 #endif
-    } else {
-        // The object storage.
-        std::aligned_storage_t<sizeof(Type), alignof(Type)> storage;
 
-        // Create the object at the storage.
-        std::unique_ptr<Type, void (*)(Type *)> object(
-            access::placement_new<Type>(std::addressof(storage)),
-            [](auto pointer) { access::destruct(*pointer); });
+        // Resize the container to match the size.
+        container.resize(size);
+
+        // Decode the values, refilling the reader from the archive.
+        detail::bit_reader reader;
+        detail::float_codec<bits_type> codec;
+        std::size_t remaining = compressed_size;
+        for (auto & item : container) {
+            if (reader.available() < detail::bit_reader::refill_size &&
+                remaining) {
+                auto count = std::min(
+                    remaining, detail::bit_reader::capacity - reader.available());
+#ifndef ZPP_SERIALIZER_FREESTANDING
+                archive(as_bytes(reader.prepare(), count));
+#else
+                if (auto result = archive(as_bytes(reader.prepare(), count));
+                    !result) {
+                    return result;
+                }
+#endif
+                reader.commit(count);
+                remaining -= count;
+            }
 
-        // Load the object.
+            bits_type bits{};
+            if (!codec.decode(reader, bits)) {
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        archive(*object);
+                throw out_of_range("Invalid compressed floating point data.");
 #else
-        if (auto result = archive(*optional); !result) {
-            return result;
-        }
+                return freestanding::error{error::out_of_range};
 #endif
+            }
+            std::memcpy(std::addressof(item), std::addressof(bits), sizeof(bits));
+        }
 
-        // Assign the loaded object.
-        optional = std::move(*object);
-    }
+        // The compressed size must have been consumed exactly.
+        if (remaining || reader.overrun() || reader.available()) {
+#ifndef ZPP_SERIALIZER_FREESTANDING
+            throw out_of_range("Invalid compressed floating point data.");
+#else
+            return freestanding::error{error::out_of_range};
+#endif
+        }
 
 #ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
+        return freestanding::error{error::success};
 #endif
-}
-
-/**
- * Serialize std::optional, operates on saving (output) archives.
- */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::optional<Type> & optional)
-{
-    // Save has value.
-    bool has_value = optional.has_value();
-
-    // If has value, save it.
-    if (has_value) {
-        return archive(has_value, *optional);
-    } else {
-        return archive(has_value);
     }
-}
-
-/**
- * Serialize std::variant, operates on loading (input) archives.
- */
-template <typename Archive,
-          typename... Types,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::variant<Types...> & variant)
-{
-    // Test for maximum number of types.
-    static_assert(sizeof...(Types) < 0xff, "Max variant types reached.");
 
-    // The variant index.
-    unsigned char index{};
+    /**
+     * Serialize the compressed container, in case of a saving (output)
+     * archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static auto serialize_container(Archive & archive,
+                                    const Items & container)
+    {
+        // Count the compressed bits.
+        detail::bit_counter counter;
+        {
+            detail::float_codec<bits_type> codec;
+            for (auto & item : container) {
+                bits_type bits{};
+                std::memcpy(std::addressof(bits), std::addressof(item), sizeof(bits));
+                codec.encode(bits, counter);
+            }
+        }
 
-    // Load the index.
+        // Save the number of values and the compressed size.
 #ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(index);
+        archive(static_cast<size_type>(container.size()),
+                static_cast<size_type>((counter.count() + 7) / 8));
 #else
-    if (auto result = archive(index); !result) {
-        return result;
-    }
+        if (auto result =
+                archive(static_cast<size_type>(container.size()),
+                        static_cast<size_type>((counter.count() + 7) / 8));
+            !result) {
+            return result;
+        }
 #endif
 
-    // Check that loaded index is inside bounds.
-    if (index >= sizeof...(Types)) {
+        // Encode the values, flushing the writer into the archive.
+        detail::bit_writer writer;
+        detail::float_codec<bits_type> codec;
+        for (auto & item : container) {
+            bits_type bits{};
+            std::memcpy(std::addressof(bits), std::addressof(item), sizeof(bits));
+            codec.encode(bits, writer);
+            if (writer.size() >= detail::bit_writer::flush_size) {
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        throw variant_index_out_of_range("Variant index out of range");
+                archive(as_bytes(writer.data(), writer.size()));
 #else
-        return freestanding::error{error::out_of_range};
+                if (auto result =
+                        archive(as_bytes(writer.data(), writer.size()));
+                    !result) {
+                    return result;
+                }
 #endif
-    }
-
-    // The variant type.
-    using variant_type = std::variant<Types...>;
-
-    // Loader type.
-    using loader_type =
-        void (*)(Archive & archive, variant_type & variant);
-
-    // Loaders per variant index.
-    static constexpr loader_type loaders[] = {[](auto & archive,
-                                                 auto & variant) {
-        // If the type is default constructible.
-        if constexpr (std::is_default_constructible_v<Types>) {
-            // If does not have the needed type, assign it.
-            if (!std::get_if<Types>(&variant)) {
-                variant = Types{};
+                writer.clear();
             }
+        }
 
-            // Load the value.
-            return archive(*std::get_if<Types>(&variant));
-        } else {
-            // The object storage.
-            std::aligned_storage_t<sizeof(Types), alignof(Types)> storage;
-
-            // Create the object at the storage.
-            std::unique_ptr<Types, void (*)(Types *)> object(
-                access::placement_new<Types>(std::addressof(storage)),
-                [](auto pointer) { access::destruct(*pointer); });
+        // Save the rest of the compressed bits.
+        writer.finish();
+        return archive(as_bytes(writer.data(), writer.size()));
+    }
 
-            // Load the object.
 #ifndef ZPP_SERIALIZER_FREESTANDING
-            archive(*object);
-#else
-            if (auto result = archive(*object); !result) {
-                return result;
-            }
-#endif
+    /**
+     * Serialize the compressed container, in case of a skipping archive.
+     * The compressed bits are skipped without decoding them, and the
+     * container is left untouched.
+     */
+    template <typename Items>
+    static void serialize_container(skipping_archive & archive, Items &)
+    {
+        size_type size{};
+        size_type compressed_size{};
 
-            // Assign the loaded object.
-            variant = std::move(*object);
+        // Fetch the number of values and the compressed size.
+        archive(size, compressed_size);
+        if (archive.failed()) {
+            return;
         }
-    }...};
 
-    // Execute the appropriate loader.
-    return loaders[index](archive, variant);
-}
+        // Every value but the first takes at least one bit.
+        if (size && std::uint64_t(compressed_size) * 8 <
+                        sizeof(bits_type) * 8 + (size - 1)) {
+            throw out_of_range("Compressed floating point data is too small.");
+        }
+
+        // Skip the compressed bits.
+        archive.advance(compressed_size);
+    }
+#endif
+};
 
 /**
- * Serialize std::variant, operates on saving (output) archives.
+ * Creates a wrapper object of float_compressed_container to allow
+ * serialization of a floating point container compressed.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::float_compressed(self.m_samples));
+ * ~~~
  */
-template <typename Archive,
-          typename... Types,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::variant<Types...> & variant)
+template <typename Container>
+auto float_compressed(Container && container)
 {
-    // Test for maximum number of types.
-    static_assert(sizeof...(Types) < 0xff, "Max variant types reached.");
-
-    // The variant index.
-    auto variant_index = variant.index();
+    return float_compressed_container<std::remove_reference_t<Container>>(
+        container);
+}
 
-    // Disallow serializations of valueless variant.
-    if (std::variant_npos == variant_index) {
 #ifndef ZPP_SERIALIZER_FREESTANDING
-        throw attempt_to_serialize_valueless_variant(
-            "Cannot serialize a valueless variant.");
-#else
-        return freestanding::error{error::variant_is_valueless};
-#endif
-    }
-
-    // The index to save.
-    auto index = static_cast<unsigned char>(variant_index & 0xff);
-
-    // Save the variant object.
-    return std::visit(
-        [index, &archive](auto & object) {
-            return archive(index, object);
-        },
-        variant);
-}
-#endif
+/**
+ * The minimum number of items in a segment of a container that is saved
+ * in parallel.
+ */
+constexpr std::size_t min_parallel_segment_size = 1024;
 
+namespace detail
+{
 /**
- * Serialize std::unique_ptr of non polymorphic, in case of a loading
- * (input) archive.
+ * A range of items that are serialized one after the other, without a
+ * leading size.
  */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename =
-              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::unique_ptr<Type> & object)
+template <typename Iterator>
+class item_range
 {
-    // Construct a new object.
-    auto loaded_object = access::make_unique<Type>();
+public:
+    /**
+     * Constructs the range from the first and last iterators.
+     */
+    item_range(Iterator first, Iterator last) : first(first), last(last)
+    {
+    }
 
-    // Serialize the object.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(*loaded_object);
-#else
-    if (auto result = archive(*loaded_object); !result) {
-        return result;
+    /**
+     * Serialize the items.
+     */
+    template <typename Archive, typename Self>
+    static void serialize(Archive & archive, Self & self)
+    {
+        for (auto item = self.first; item != self.last; ++item) {
+            archive(*item);
+        }
     }
-#endif
 
-    // Transfer the object.
-    object.reset(loaded_object.release());
+    /**
+     * The first item.
+     */
+    Iterator first;
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+    /**
+     * One past the last item.
+     */
+    Iterator last;
+};
 
 /**
- * Serialize std::unique_ptr of non polymorphic, in case of a saving
- * (output) archive.
+ * Returns the given number of threads, or the number of hardware threads
+ * if zero.
  */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename =
-              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::unique_ptr<Type> & object)
+inline std::size_t thread_count_or_default(std::size_t thread_count)
 {
-    // Prevent serialization of null pointers.
-    if (nullptr == object) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        throw attempt_to_serialize_null_pointer_error(
-            "Attempt to serialize null pointer.");
-#else
-        return freestanding::error{error::null_pointer_serialization};
-#endif
+    if (thread_count) {
+        return thread_count;
     }
-
-    // Serialize the object.
-    return archive(*object);
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
 }
 
-#ifndef ZPP_SERIALIZER_FREESTANDING
 /**
- * Serialize std::unique_ptr of polymorphic, in case of a loading (input)
- * archive.
+ * Invokes the function with every index up to 'count', on up to
+ * 'thread_count' threads including the calling thread. Every thread
+ * takes the next index once done with its previous one.
  */
-template <
-    typename Archive,
-    typename Type,
-    typename...,
-    typename = std::enable_if_t<std::is_base_of<polymorphic, Type>::value>,
-    typename = typename Archive::loading,
-    typename = void>
-void serialize(Archive & archive, std::unique_ptr<Type> & object)
+template <typename Function>
+void parallel_for(std::size_t count,
+                  std::size_t thread_count,
+                  Function && function)
 {
-    std::unique_ptr<polymorphic> loaded_type;
+    std::atomic<std::size_t> next{};
 
-    // Get the instance of the polymorphic registry.
-    auto & registry_instance = registry<Archive>::get_instance();
-
-    // Serialize the object using the registry.
-    registry_instance.serialize(archive, loaded_type);
-
-    try {
-        // Check if the loaded type is convertible to Type.
-        object.reset(&dynamic_cast<Type &>(*loaded_type));
+    // Invoke the function with the next index, until done.
+    auto worker = [&] {
+        try {
+            for (std::size_t index{}; (index = next++) < count;) {
+                function(index);
+            }
+        } catch (...) {
+            // Stop the other threads.
+            next = count;
+            throw;
+        }
+    };
 
-        // Release the object.
-        loaded_type.release();
-    } catch (const std::bad_cast &) {
-        // The loaded type was not convertible to Type.
-        throw polymorphic_type_mismatch_error(
-            "Polymorphic serialization type mismatch.");
+    // Start the other threads, and work on this thread as well.
+    std::vector<std::future<void>> tasks;
+    auto task_count = std::min(thread_count, count);
+    for (std::size_t index = 1; index < task_count; ++index) {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto & task : tasks) {
+        task.get();
     }
 }
 
 /**
- * Serialize std::unique_ptr of polymorphic, in case of a saving (output)
- * archive.
+ * Returns a pointer to the next 'size' bytes of the input, for archives
+ * that expose their input, without copying them.
  */
-template <
-    typename Archive,
-    typename Type,
-    typename...,
-    typename = std::enable_if_t<std::is_base_of<polymorphic, Type>::value>,
-    typename = typename Archive::saving,
-    typename = void>
-void serialize(Archive & archive, const std::unique_ptr<Type> & object)
+template <typename Archive>
+auto input_bytes_of(Archive & archive,
+                    std::size_t size,
+                    std::vector<unsigned char> &,
+                    int) -> decltype(archive.reset(archive.offset()),
+                                     archive.data() + archive.remaining())
 {
-    // Prevent serialization of null pointers.
-    if (nullptr == object) {
-        throw attempt_to_serialize_null_pointer_error(
-            "Attempt to serialize null pointer.");
+    if (size > archive.remaining()) {
+        throw out_of_range("Input was not large enough to contain the "
+                           "requested items");
     }
 
-    // Get the instance of the polymorphic registry.
-    auto & registry_instance = registry<Archive>::get_instance();
+    auto data = archive.data() + archive.offset();
+    archive.reset(archive.offset() + size);
+    return data;
+}
 
-    // Serialize the object using the registry.
-    registry_instance.serialize(archive, *object);
+/**
+ * Returns a pointer to the next 'size' bytes of the input, which are
+ * loaded into the given buffer.
+ */
+template <typename Archive>
+const unsigned char * input_bytes_of(Archive & archive,
+                                     std::size_t size,
+                                     std::vector<unsigned char> & buffer,
+                                     ...)
+{
+    buffer.resize(size);
+    if (size) {
+        archive(as_bytes(buffer.data(), size));
+    }
+    return buffer.data();
 }
-#endif // ZPP_SERIALIZER_FREESTANDING
+} // namespace detail
 
 /**
- * Serialize std::shared_ptr of non polymorphic, in case of a loading
- * (input) archive.
+ * Represents a random access container that is saved in parallel.
+ * The container is split into segments, that are saved concurrently each
+ * into its own buffer, and then gathered into the archive, in the same
+ * format as saving the container serially.
+ * Saving is serial unless the archive is a memory output archive without
+ * a string dictionary or an object tracker, whose state depends on the
+ * items saved before, and the container items are saved one by one.
+ * Loading is serial.
  */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename =
-              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
-          typename = typename Archive::loading>
-auto serialize(Archive & archive, std::shared_ptr<Type> & object)
+template <typename Container>
+class parallel_output_container
 {
-    // Construct a new object.
-    auto loaded_object = access::make_unique<Type>();
+public:
+    /**
+     * Constructs the parallel output container from the container and
+     * the number of threads, zero means the number of hardware threads.
+     */
+    parallel_output_container(Container & container,
+                              std::size_t thread_count) :
+        container(container),
+        thread_count(detail::thread_count_or_default(thread_count))
+    {
+    }
 
-    // Serialize the object.
-#ifndef ZPP_SERIALIZER_FREESTANDING
-    archive(*loaded_object);
-#else
-    if (auto result = archive(*loaded_object); !result) {
-        return result;
+    /**
+     * Serialize the container.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_container(
+            archive, self.container, self.thread_count);
     }
-#endif
 
-    // Transfer the object.
-    object.reset(loaded_object.release());
+    /**
+     * The wrapped container.
+     */
+    Container & container;
 
-#ifdef ZPP_SERIALIZER_FREESTANDING
-    return freestanding::error{error::success};
-#endif
-}
+    /**
+     * The number of threads to save with.
+     */
+    std::size_t thread_count{};
+
+private:
+    /**
+     * Serialize the container, in case of a loading (input) archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::loading>
+    static void
+    serialize_container(Archive & archive, Items & container, std::size_t)
+    {
+        archive(container);
+    }
+
+    /**
+     * Serialize the container, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static void serialize_container(Archive & archive,
+                                    Items & container,
+                                    std::size_t thread_count)
+    {
+        // Save in parallel only random access sequence containers into
+        // memory output archives, else save serially.
+        using parallel = std::integral_constant<
+            bool,
+            std::is_same<Archive, basic_memory_output_archive>::value &&
+                std::is_base_of<detail::sequence_container_tag,
+                                detail::container_category_t<
+                                    std::remove_const_t<Items>>>::value &&
+                std::is_base_of<std::random_access_iterator_tag,
+                                typename std::iterator_traits<
+                                    decltype(std::begin(container))>::
+                                    iterator_category>::value>;
+        save_container(archive, container, thread_count, parallel{});
+    }
+
+    /**
+     * Save the container serially.
+     */
+    template <typename Archive, typename Items>
+    static void save_container(Archive & archive,
+                               Items & container,
+                               std::size_t,
+                               std::false_type)
+    {
+        archive(container);
+    }
+
+    /**
+     * Save the container in parallel, for random access sequence
+     * containers and memory output archives.
+     */
+    template <typename Archive, typename Items>
+    static void save_container(Archive & archive,
+                               Items & container,
+                               std::size_t thread_count,
+                               std::true_type)
+    {
+        // The number of items and segments.
+        auto size = container.size();
+        auto segment_count =
+            std::min(thread_count, size / min_parallel_segment_size);
+
+        // Save serially when the state of the archive depends on the
+        // items saved before, or when there is too little to split.
+        if (segment_count < 2 || detail::dictionary_of(archive, 0) ||
+            detail::tracker_of(archive, 0)) {
+            archive(container);
+            return;
+        }
+
+        // Save the container size.
+        archive(static_cast<size_type>(size));
+
+        // Save the segments concurrently, each into its own buffer.
+        std::vector<std::vector<unsigned char>> segments(segment_count);
+        detail::parallel_for(
+            segment_count, segment_count, [&](std::size_t index) {
+                auto first = std::begin(container);
+                memory_output_archive out(segments[index]);
+                out(detail::item_range<decltype(first)>(
+                    first + size * index / segment_count,
+                    first + size * (index + 1) / segment_count));
+            });
+
+        // Gather the segments into the archive.
+        for (auto & segment : segments) {
+            archive(as_bytes(segment.data(), segment.size()));
+        }
+    }
+};
 
 /**
- * Serialize std::shared_ptr of non polymorphic, in case of a saving
- * (output) archive.
+ * Creates a wrapper object of parallel_output_container to allow saving a
+ * large random access container on multiple threads, in the same format
+ * as saving it serially.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::parallel_output(self.m_records));
+ * ~~~
  */
-template <typename Archive,
-          typename Type,
-          typename...,
-          typename =
-              std::enable_if_t<!std::is_base_of<polymorphic, Type>::value>,
-          typename = typename Archive::saving>
-auto serialize(Archive & archive, const std::shared_ptr<Type> & object)
+template <typename Container>
+auto parallel_output(Container && container, std::size_t thread_count = 0)
 {
-    // Prevent serialization of null pointers.
-    if (nullptr == object) {
-#ifndef ZPP_SERIALIZER_FREESTANDING
-        throw attempt_to_serialize_null_pointer_error(
-            "Attempt to serialize null pointer.");
-#else
-        return freestanding::error{error::null_pointer_serialization};
-#endif
-    }
-
-    // Serialize the object.
-    return archive(*object);
+    return parallel_output_container<std::remove_reference_t<Container>>(
+        container, thread_count);
 }
 
 /**
- * Represents a container object with specific
- * size type requirements.
+ * The default number of items in a segment of a segmented container.
  */
-template <typename SizeType, typename Container>
-class sized_container
+constexpr std::size_t default_segment_size = 4096;
+
+/**
+ * Represents a random access container that is serialized in segments,
+ * which are independent of each other and are preceded by a table of
+ * their sizes, so that they can be saved and loaded in parallel.
+ * The format is the number of items, the number of segments, the size in
+ * bytes of every segment as std::uint64_t, followed by the segments.
+ * Items in segments are serialized without the string dictionary or
+ * object tracker of the archive. When loading, the allocation budget of
+ * the archive is split evenly among the segments.
+ */
+template <typename Container>
+class segmented_container
 {
 public:
+    static_assert(
+        !detail::is_bool_vector<std::remove_const_t<Container>>::value,
+        "Items of std::vector<bool> cannot be loaded concurrently.");
+
     /**
-     * Must be class type.
+     * Constructs the segmented container from the container, the number
+     * of items in a segment, and the number of threads, zero means the
+     * number of hardware threads.
      */
-    static_assert(std::is_class<Container>::value,
-                  "Container must be a class type.");
+    segmented_container(Container & container,
+                        std::size_t segment_size,
+                        std::size_t thread_count) :
+        container(container),
+        segment_size(segment_size ? segment_size : 1),
+        thread_count(detail::thread_count_or_default(thread_count))
+    {
+    }
 
     /**
-     * Must be unsigned integral type.
+     * Serialize the container.
      */
-    static_assert(std::is_unsigned<SizeType>::value,
-                  "Size must be an unsigned integral type.");
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_container(
+            archive, self.container, self.segment_size, self.thread_count);
+    }
 
-    /*
-     * Construct the sized container.
+    /**
+     * The wrapped container.
      */
-    explicit sized_container(Container & container) : container(container)
+    Container & container;
+
+    /**
+     * The number of items in a segment.
+     */
+    std::size_t segment_size{};
+
+    /**
+     * The number of threads to serialize with.
+     */
+    std::size_t thread_count{};
+
+private:
+    /**
+     * Serialize the container, in case of a loading (input) archive.
+     * The container is resized and its segments are loaded concurrently.
+     */
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::loading>
+    static void serialize_container(Archive & archive,
+                                    Items & container,
+                                    std::size_t,
+                                    std::size_t thread_count)
     {
+        // Fetch the number of items and segments.
+        size_type size{};
+        size_type segment_count{};
+        archive(size, segment_count);
+
+        // Check that every segment has items.
+        if (segment_count > size || (size && !segment_count)) {
+            throw out_of_range("Segment table out of range.");
+        }
+
+        // Fetch the segment sizes.
+        detail::verify_load_size(archive,
+                                 segment_count,
+                                 sizeof(std::uint64_t),
+                                 sizeof(std::uint64_t));
+        std::vector<std::uint64_t> segment_sizes(segment_count);
+        if (segment_count) {
+            archive(as_bytes(segment_sizes.data(), segment_count));
+        }
+
+        // Compute the segment offsets, and check that the segments are
+        // within the input.
+        auto remaining = detail::remaining_of(archive, 0);
+        std::vector<std::size_t> offsets(segment_count + 1);
+        for (std::size_t index{}; index < segment_count; ++index) {
+            if (segment_sizes[index] > remaining - offsets[index]) {
+                throw out_of_range("Segment table out of range.");
+            }
+            offsets[index + 1] =
+                offsets[index] + std::size_t(segment_sizes[index]);
+        }
+
+        // Deduce the container item type.
+        using item_type = typename Items::value_type;
+
+        // Verify the size against the segments and allocation budget.
+        detail::verify_load_size(
+            archive,
+            size,
+            detail::min_serialized_size<item_type>::value,
+            sizeof(item_type));
+
+        // Fetch the segments.
+        std::vector<unsigned char> buffer;
+        auto data = detail::input_bytes_of(
+            archive, offsets[segment_count], buffer, 0);
+
+        // Split the remaining allocation budget evenly among the segments,
+        // unless unlimited, so that the items of all segments together
+        // allocate no more than the budget.
+        auto budget = detail::allocation_budget_of(archive, 0);
+        auto unlimited = (std::numeric_limits<std::size_t>::max)();
+        auto segment_budget =
+            (budget == unlimited || !segment_count) ? budget
+                                                    : budget / segment_count;
+        std::vector<std::size_t> consumed(segment_count);
+
+        // The input archive of a segment, which must be loaded in full.
+        auto segment_archive = [&](std::size_t index) {
+            memory_view_input_archive in(
+                data + offsets[index], offsets[index + 1] - offsets[index]);
+            in.set_allocation_budget(segment_budget);
+            return in;
+        };
+        auto verify_loaded = [&](memory_view_input_archive & in,
+                                 std::size_t index) {
+            if (in.remaining()) {
+                throw out_of_range("Segment table out of range.");
+            }
+            consumed[index] = segment_budget - in.allocation_budget();
+        };
+
+        // Consumes what the segments allocated from the archive budget.
+        auto consume_budget = [&] {
+            if (budget != unlimited) {
+                std::size_t total{};
+                for (auto size : consumed) {
+                    total += size;
+                }
+                detail::consume_allocation_budget_of(archive, total, 0);
+            }
+        };
+
+        // If items may be serialized in no bytes, the size is not bounded
+        // by the input, so every segment is loaded into a buffer that
+        // grows as items are loaded, and then moved into the container.
+        if (!detail::min_serialized_size<item_type>::value) {
+            std::vector<std::vector<item_type>> segments(segment_count);
+            detail::parallel_for(
+                segment_count, thread_count, [&](std::size_t index) {
+                    auto in = segment_archive(index);
+                    detail::load_items(in,
+                                       segments[index],
+                                       size * (index + 1) / segment_count -
+                                           size * index / segment_count,
+                                       0,
+                                       std::random_access_iterator_tag{});
+                    verify_loaded(in, index);
+                });
+            consume_budget();
+
+            container.resize(size);
+            auto item = std::begin(container);
+            for (auto & segment : segments) {
+                item = std::move(segment.begin(), segment.end(), item);
+            }
+            return;
+        }
+
+        // Load the segments concurrently.
+        container.resize(size);
+        detail::parallel_for(
+            segment_count, thread_count, [&](std::size_t index) {
+                auto first = std::begin(container);
+                auto in = segment_archive(index);
+                in(detail::item_range<decltype(first)>(
+                    first + size * index / segment_count,
+                    first + size * (index + 1) / segment_count));
+                verify_loaded(in, index);
+            });
+        consume_budget();
     }
 
     /**
-     * Call serialize directly with the size type parameter.
+     * Serialize the container, in case of a saving (output) archive.
+     * The segments are saved concurrently each into its own buffer.
      */
-    template <typename Archive, typename Self>
-    static auto serialize(Archive & archive, Self & self)
+    template <typename Archive,
+              typename Items,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static void serialize_container(Archive & archive,
+                                    Items & container,
+                                    std::size_t segment_size,
+                                    std::size_t thread_count)
     {
-        using zpp::serializer::serialize;
-        return serialize<Archive, Container, SizeType>(archive,
-                                                       self.container);
+        // The number of items and segments.
+        auto size = container.size();
+        auto segment_count = (size + segment_size - 1) / segment_size;
+
+        // Save the segments concurrently, each into its own buffer.
+        std::vector<std::vector<unsigned char>> segments(segment_count);
+        detail::parallel_for(
+            segment_count, thread_count, [&](std::size_t index) {
+                auto first = std::begin(container);
+                memory_output_archive out(segments[index]);
+                out(detail::item_range<decltype(first)>(
+                    first + size * index / segment_count,
+                    first + size * (index + 1) / segment_count));
+            });
+
+        // Save the number of items and segments, and the segment sizes.
+        archive(static_cast<size_type>(size),
+                static_cast<size_type>(segment_count));
+        for (auto & segment : segments) {
+            archive(static_cast<std::uint64_t>(segment.size()));
+        }
+
+        // Save the segments.
+        for (auto & segment : segments) {
+            archive(as_bytes(segment.data(), segment.size()));
+        }
     }
 
     /**
-     * The wrapped container type.
+     * Serialize the container, in case of a skipping archive.
+     * The segments are skipped by the sum of the segment table, and the
+     * container is left untouched.
      */
-    Container & container;
+    template <typename Items>
+    static void serialize_container(skipping_archive & archive,
+                                    Items &,
+                                    std::size_t,
+                                    std::size_t)
+    {
+        // Fetch the number of items and segments.
+        size_type size{};
+        size_type segment_count{};
+        archive(size, segment_count);
+        if (archive.failed()) {
+            return;
+        }
+
+        // Check that every segment has items.
+        if (segment_count > size || (size && !segment_count)) {
+            throw out_of_range("Segment table out of range.");
+        }
+
+        // Skip the segment sizes, then the segments they sum up to.
+        detail::verify_load_size(
+            archive, segment_count, sizeof(std::uint64_t), 0);
+        auto remaining =
+            archive.remaining() - segment_count * sizeof(std::uint64_t);
+        std::size_t segments_size{};
+        for (size_type index{}; index < segment_count; ++index) {
+            std::uint64_t segment_size{};
+            archive(segment_size);
+            if (segment_size > remaining - segments_size) {
+                archive.fail();
+                return;
+            }
+            segments_size += std::size_t(segment_size);
+        }
+        archive.advance(segments_size);
+    }
 };
 
 /**
- * Creates a wrapper object of sized_container to
- * allow serialization with specific size type requirements.
+ * Creates a wrapper object of segmented_container to allow saving and
+ * loading a large random access container in independent segments, on
+ * multiple threads.
+ * Example:
+ * ~~~
+ * archive(zpp::serializer::segmented(self.m_records));
+ * ~~~
  */
-template <typename SizeType, typename Container>
-auto size_is(Container && container)
+template <typename Container>
+auto segmented(Container && container,
+               std::size_t segment_size = default_segment_size,
+               std::size_t thread_count = 0)
 {
-    return sized_container<SizeType, std::remove_reference_t<Container>>(
-        container);
+    return segmented_container<std::remove_reference_t<Container>>(
+        container, segment_size, thread_count);
 }
+#endif
 
 #ifndef ZPP_SERIALIZER_FREESTANDING
 /**
@@ -3005,6 +10807,34 @@ template <
     typename = void>
 void serialize(Archive & archive, std::shared_ptr<Type> & object)
 {
+    // Fetch the object tracker of the archive.
+    auto tracker = detail::tracker_of(archive, 0);
+
+    // If tracking objects, check for an already loaded object.
+    std::size_t id{};
+    if (tracker) {
+        size_type reference{};
+        archive(reference);
+        if (reference) {
+            auto loaded_object = std::static_pointer_cast<polymorphic>(
+                tracker->at(reference - 1, detail::type_key<polymorphic>()));
+
+            // Check if the loaded object is convertible to Type.
+            auto derived = dynamic_cast<Type *>(loaded_object.get());
+            if (!derived) {
+                throw polymorphic_type_mismatch_error(
+                    "Polymorphic serialization type mismatch.");
+            }
+
+            // Share the loaded object.
+            object = std::shared_ptr<Type>(loaded_object, derived);
+            return;
+        }
+
+        // Reserve the id of the object, set once loaded.
+        id = tracker->add(nullptr, detail::type_key<polymorphic>());
+    }
+
     std::unique_ptr<polymorphic> loaded_type;
 
     // Get the instance of the polymorphic registry.
@@ -3013,6 +10843,12 @@ void serialize(Archive & archive, std::shared_ptr<Type> & object)
     // Serialize the object using the registry.
     registry_instance.serialize(archive, loaded_type);
 
+    // Archives with sticky errors may load no object.
+    if (!loaded_type) {
+        object = nullptr;
+        return;
+    }
+
     try {
         // Check if the loaded type is convertible to Type.
         object.reset(&dynamic_cast<Type &>(*loaded_type));
@@ -3024,6 +10860,11 @@ void serialize(Archive & archive, std::shared_ptr<Type> & object)
         throw polymorphic_type_mismatch_error(
             "Polymorphic serialization type mismatch.");
     }
+
+    // Track the loaded object.
+    if (tracker) {
+        tracker->set(id, std::shared_ptr<polymorphic>(object));
+    }
 }
 
 /**
@@ -3045,6 +10886,18 @@ void serialize(Archive & archive, const std::shared_ptr<Type> & object)
             "Attempt to serialize null pointer.");
     }
 
+    // If tracking objects, save the reference, and stop unless this is
+    // the first occurrence of the object.
+    if (auto tracker = detail::tracker_of(archive, 0)) {
+        auto reference =
+            tracker->save(dynamic_cast<const void *>(object.get()),
+                          detail::type_key<polymorphic>());
+        archive(static_cast<size_type>(reference));
+        if (reference) {
+            return;
+        }
+    }
+
     // Get the instance of the polymorphic registry.
     auto & registry_instance = registry<Archive>::get_instance();
 
@@ -3052,6 +10905,452 @@ void serialize(Archive & archive, const std::shared_ptr<Type> & object)
     registry_instance.serialize(archive, *object);
 }
 
+namespace detail
+{
+/**
+ * Skips the object pointed to by a pointer of non polymorphic type.
+ */
+template <typename Type>
+void skip_pointed_object(skipping_archive & archive, std::false_type)
+{
+    archive(skipped_object<Type>());
+}
+
+/**
+ * Skips the object pointed to by a pointer of polymorphic type, using the
+ * skip method registered for its id.
+ */
+template <typename Type>
+void skip_pointed_object(skipping_archive & archive, std::true_type)
+{
+    std::unique_ptr<polymorphic> object;
+    registry<skipping_archive>::get_instance().serialize(archive, object);
+}
+} // namespace detail
+
+/**
+ * Skip std::unique_ptr, operates on skipping archives.
+ */
+template <typename Type>
+void serialize(skipping_archive & archive, std::unique_ptr<Type> &)
+{
+    detail::skip_pointed_object<Type>(
+        archive, std::is_base_of<polymorphic, Type>{});
+}
+
+/**
+ * Skip std::shared_ptr, operates on skipping archives.
+ */
+template <typename Type>
+void serialize(skipping_archive & archive, std::shared_ptr<Type> &)
+{
+    detail::skip_pointed_object<Type>(
+        archive, std::is_base_of<polymorphic, Type>{});
+}
+
+/**
+ * Skip std::shared_ptr of const std::string, in one step, operates on
+ * skipping archives.
+ */
+inline void serialize(skipping_archive & archive,
+                      std::shared_ptr<const std::string> &)
+{
+    size_type size{};
+    archive(size);
+    detail::skip_bytes_items<char>(archive, size);
+}
+
+#if __cplusplus >= 201703L
+/**
+ * Skip std::optional, operates on skipping archives.
+ */
+template <typename Type>
+void serialize(skipping_archive & archive, std::optional<Type> &)
+{
+    bool has_value{};
+    archive(has_value);
+    if (has_value) {
+        archive(detail::skipped_object<Type>());
+    }
+}
+
+/**
+ * Skip std::variant, operates on skipping archives.
+ */
+template <typename... Types>
+void serialize(skipping_archive & archive, std::variant<Types...> &)
+{
+    // The skip function of every alternative, by index.
+    using skip_function = void (*)(skipping_archive &);
+    constexpr skip_function skip_functions[] = {
+        [](skipping_archive & archive) {
+            archive(detail::skipped_object<Types>());
+        }...};
+
+    // Load the index, and check that it is inside bounds.
+    unsigned char index{};
+    archive(index);
+    if (index >= sizeof...(Types)) {
+        throw variant_index_out_of_range("Variant index out of range");
+    }
+
+    // Skip the alternative.
+    skip_functions[index](archive);
+}
+#endif
+
+namespace detail
+{
+/**
+ * Selects members by their position in the member list.
+ */
+template <std::size_t... Indices>
+struct position_selector
+{
+    bool operator()(std::size_t index, const void *) const noexcept
+    {
+        constexpr std::array<std::size_t, sizeof...(Indices)> indices{
+            {Indices...}};
+        return std::find(indices.begin(), indices.end(), index) !=
+               indices.end();
+    }
+};
+
+/**
+ * Selects members by their address, given by pointers to members.
+ */
+template <std::size_t Count>
+struct member_selector
+{
+    bool operator()(std::size_t, const void * address) const noexcept
+    {
+        return std::find(addresses.begin(), addresses.end(), address) !=
+               addresses.end();
+    }
+
+    /**
+     * The addresses of the selected members.
+     */
+    std::array<const void *, Count> addresses;
+};
+
+/**
+ * An archive that numbers the items of an object as they are serialized,
+ * loads the selected items with the given loading (input) archive, and
+ * skips the rest with a skipping archive.
+ */
+template <typename Archive, typename Selector>
+class projecting_archive
+{
+public:
+    /**
+     * Loading archive.
+     */
+    using loading = void;
+
+    /**
+     * Constructs the projecting archive from the input archive and the
+     * selector of the items to load.
+     */
+    projecting_archive(Archive & archive,
+                       const Selector & selector) noexcept :
+        m_archive(archive),
+        m_selector(selector)
+    {
+    }
+
+    /**
+     * Load the selected items and skip the rest, in order.
+     */
+    template <typename... Items>
+    void operator()(Items &&... items)
+    {
+        int expand[] = {0, (project(std::forward<Items>(items)), 0)...};
+        (void)expand;
+    }
+
+private:
+    /**
+     * Load the item if selected, else skip it.
+     */
+    template <typename Item>
+    void project(Item && item)
+    {
+        if (m_selector(m_index++, std::addressof(item))) {
+            m_archive(std::forward<Item>(item));
+        } else {
+            skip(m_archive, item, 0);
+        }
+    }
+
+    /**
+     * Skip the item, for skipping archives, which skip it directly.
+     */
+    template <typename Item>
+    static void skip(skipping_archive & archive, Item & item, int)
+    {
+        archive(skipped_item(item, std::is_default_constructible<Item>{}));
+    }
+
+    /**
+     * Skip bytes data, for skipping archives, by advancing past it.
+     */
+    template <typename Item>
+    static void skip(skipping_archive & archive, bytes<Item> & item, int)
+    {
+        archive.advance(item.size_in_bytes());
+    }
+
+    /**
+     * Skip bytes data, by advancing past it, so that it is left
+     * untouched.
+     */
+    template <typename InputArchive, typename Item>
+    static auto skip(InputArchive & archive, bytes<Item> & item, int)
+        -> decltype(archive.reset(archive.offset()),
+                    void(archive.data() + archive.remaining()))
+    {
+        skip_input(archive, [&](skipping_archive & skipper) {
+            skipper.advance(item.size_in_bytes());
+        });
+    }
+
+    /**
+     * Skip the item, for archives that expose their input.
+     */
+    template <typename InputArchive, typename Item>
+    static auto skip(InputArchive & archive, Item & item, int)
+        -> decltype(archive.reset(archive.offset()),
+                    void(archive.data() + archive.remaining()))
+    {
+        skip_input(archive, [&](skipping_archive & skipper) {
+            skipper(
+                skipped_item(item, std::is_default_constructible<Item>{}));
+        });
+    }
+
+    /**
+     * Skips the input of the archive with a sticky skipping archive,
+     * given to the skip function, then moves the archive past the
+     * skipped input. If the input is not large enough, archives with
+     * sticky errors fail, without resetting them, and other archives
+     * throw. Archives that already failed skip nothing.
+     */
+    template <typename InputArchive, typename SkipFunction>
+    static void skip_input(InputArchive & archive, SkipFunction && skip)
+    {
+        if (failed_of(archive, 0)) {
+            return;
+        }
+
+        skipping_archive skipper(archive.data(),
+                                 archive.offset() + archive.remaining());
+        skipper.reset(archive.offset());
+        skipper.make_sticky();
+        skip(skipper);
+
+        if (skipper.failed()) {
+            if (!fail_of(archive, 0)) {
+                throw out_of_range("Input was not large enough to contain "
+                                   "the skipped item");
+            }
+            return;
+        }
+        archive.reset(skipper.offset());
+    }
+
+    /**
+     * Returns the skipped object of the item type, so that the item is
+     * left untouched.
+     */
+    template <typename Item>
+    static Item & skipped_item(Item &, std::true_type)
+    {
+        return skipped_object<Item>();
+    }
+
+    /**
+     * Returns the item itself, for items that cannot be default
+     * constructed, such as wrappers, which refer to the members they
+     * wrap, and skip them without touching them.
+     */
+    template <typename Item>
+    static Item & skipped_item(Item & item, std::false_type)
+    {
+        return item;
+    }
+
+    /**
+     * Skip the item, by loading it, for archives that do not expose
+     * their input.
+     */
+    template <typename InputArchive, typename Item>
+    static void skip(InputArchive & archive, Item & item, ...)
+    {
+        archive(item);
+    }
+
+    /**
+     * The input archive.
+     */
+    Archive & m_archive;
+
+    /**
+     * The selector of the items to load.
+     */
+    const Selector & m_selector;
+
+    /**
+     * The position of the next item.
+     */
+    std::size_t m_index{};
+};
+
+/**
+ * Serialize the members of the object with the projecting archive.
+ * This overload is for class types with serialize method.
+ */
+template <typename Archive,
+          typename Item,
+          typename...,
+          typename = decltype(Item::serialize(std::declval<Archive &>(),
+                                              std::declval<Item &>()))>
+void project_members(Archive & archive, Item & item, int)
+{
+    Item::serialize(archive, item);
+}
+
+/**
+ * Serialize the members of the object with the projecting archive.
+ * This overload is for types with outer serialize method, including
+ * aggregates, which are projected member by member.
+ */
+template <typename Archive, typename Item>
+auto project_members(Archive & archive, Item & item, ...)
+    -> decltype(serialize(archive, item), void())
+{
+    serialize(archive, item);
+}
+} // namespace detail
+
+/**
+ * Represents an object of which only the selected members are loaded,
+ * while the rest of the members are skipped without being constructed,
+ * and are left untouched. Wrappers of members cannot be default
+ * constructed, so they are skipped through the wrapper, which skips
+ * without touching the members it wraps.
+ * Members are numbered by their position in the items that the serialize
+ * method of the object passes to the archive, across calls, and wrapped
+ * members can only be selected by position. Saving saves the whole
+ * object.
+ */
+template <typename Item, typename Selector>
+class selected_members
+{
+public:
+    /**
+     * Constructs the selected members from the object and the selector
+     * of the members to load.
+     */
+    selected_members(Item & item, Selector selector) :
+        item(item),
+        selector(std::move(selector))
+    {
+    }
+
+    /**
+     * Serialize the object.
+     */
+    template <typename Archive, typename Self>
+    static auto serialize(Archive & archive, Self & self)
+    {
+        return serialize_members(archive, self.item, self.selector);
+    }
+
+    /**
+     * The wrapped object.
+     */
+    Item & item;
+
+    /**
+     * The selector of the members to load.
+     */
+    Selector selector;
+
+private:
+    /**
+     * Serialize the object, in case of a loading (input) archive.
+     * Only the selected members are loaded.
+     */
+    template <typename Archive,
+              typename Object,
+              typename...,
+              typename = typename Archive::loading>
+    static void serialize_members(Archive & archive,
+                                  Object & item,
+                                  const Selector & selector)
+    {
+        detail::projecting_archive<Archive, Selector> projecting(archive,
+                                                                 selector);
+        detail::project_members(projecting, item, 0);
+    }
+
+    /**
+     * Serialize the object, in case of a saving (output) archive.
+     */
+    template <typename Archive,
+              typename Object,
+              typename...,
+              typename = typename Archive::saving,
+              typename = void>
+    static void serialize_members(Archive & archive,
+                                  const Object & item,
+                                  const Selector &)
+    {
+        archive(item);
+    }
+
+    /**
+     * Serialize the object, in case of a skipping archive, that skips
+     * all the members, leaving them untouched.
+     */
+    template <typename Object>
+    static void serialize_members(skipping_archive & archive,
+                                  Object & item,
+                                  const Selector &)
+    {
+        detail::position_selector<> none;
+        detail::projecting_archive<skipping_archive,
+                                   detail::position_selector<>>
+            projecting(archive, none);
+        detail::project_members(projecting, item, 0);
+    }
+};
+
+/**
+ * Creates a wrapper object of selected_members, to load only the members
+ * at the given positions of the object.
+ */
+template <std::size_t... Indices, typename Item>
+auto select(Item && item)
+{
+    return selected_members<std::remove_reference_t<Item>,
+                            detail::position_selector<Indices...>>(
+        item, {});
+}
+
+/**
+ * Creates a wrapper object of selected_members, to load only the given
+ * members of the object, given by pointers to members.
+ */
+template <typename Item, typename... Members>
+auto select_members(Item && item, Members... members)
+{
+    return selected_members<std::remove_reference_t<Item>,
+                            detail::member_selector<sizeof...(Members)>>(
+        item, {{{std::addressof(item.*members)...}}});
+}
+
 /**
  * Serialize types wrapped with polymorphic_wrapper,
  * which is supported only for saving (output) archives.
@@ -3082,7 +11381,12 @@ struct archive_sequence
  * The built in archives.
  */
 using builtin_archives = archive_sequence<memory_view_input_archive,
-                                          basic_memory_output_archive>;
+                                          basic_memory_output_archive,
+                                          hashing_archive,
+                                          equality_archive,
+                                          skipping_archive,
+                                          sticky_memory_view_input_archive,
+                                          trusted_memory_view_input_archive>;
 
 /**
  * Makes a meta pair of type and id.